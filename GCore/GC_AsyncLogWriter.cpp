@@ -0,0 +1,293 @@
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <vector>
+#include <algorithm>
+#include <iostream>
+#include <boost/bind.hpp>
+
+#include "GC_AsyncLogWriter.h"
+#include "GC_Log.h"
+
+namespace gcore
+{
+	namespace
+	{
+		/// Writers to flush when the application terminates.
+		std::vector< AsyncLogWriter* >& writerRegistry()
+		{
+			static std::vector< AsyncLogWriter* > registry;
+			return registry;
+		}
+
+		boost::mutex& writerRegistryMutex()
+		{
+			static boost::mutex mutex;
+			return mutex;
+		}
+
+		/// Terminate handler that was installed before ours, if any.
+		std::terminate_handler previousTerminateHandler = nullptr;
+		bool isTerminateHandlerInstalled = false;
+
+		std::size_t roundUpPowerOfTwo( std::size_t value )
+		{
+			std::size_t power = 1;
+			while( power < value ) power <<= 1;
+			return power;
+		}
+	}
+
+	AsyncLogWriter::AsyncLogWriter( std::size_t queueCapacity, LogOverflowPolicy overflowPolicy )
+		: m_slots( nullptr )
+		, m_mask( roundUpPowerOfTwo( std::max< std::size_t >( queueCapacity, 2 ) ) - 1 )
+		, m_overflowPolicy( overflowPolicy )
+		, m_pushPosition( 0 )
+		, m_writePosition( 0 )
+		, m_pushedCount( 0 )
+		, m_writtenCount( 0 )
+		, m_droppedCount( 0 )
+		, m_reportedDroppedCount( 0 )
+		, m_isWriterSleeping( false )
+		, m_stop( false )
+		, m_isWriting( false )
+	{
+		m_slots = new Slot[ m_mask + 1 ];
+		for( std::size_t i = 0; i <= m_mask; ++i )
+		{
+			m_slots[i].sequence.store( i, boost::memory_order_relaxed );
+			m_slots[i].log = nullptr;
+			m_slots[i].time = 0;
+		}
+
+		{
+			boost::mutex::scoped_lock lock( writerRegistryMutex() );
+			writerRegistry().push_back( this );
+			if( !isTerminateHandlerInstalled )
+			{
+				previousTerminateHandler = std::set_terminate( &AsyncLogWriter::onTerminate );
+				isTerminateHandlerInstalled = true;
+			}
+		}
+
+		m_thread = boost::thread( boost::bind( &AsyncLogWriter::writerLoop, this ) );
+	}
+
+	AsyncLogWriter::~AsyncLogWriter()
+	{
+		{
+			boost::mutex::scoped_lock lock( writerRegistryMutex() );
+			std::vector< AsyncLogWriter* >& registry = writerRegistry();
+			registry.erase( std::remove( registry.begin(), registry.end(), this ), registry.end() );
+		}
+
+		// the writer thread write all the remaining messages before stopping
+		{
+			boost::mutex::scoped_lock lock( m_mutex );
+			m_stop = true;
+		}
+		m_wakeCondition.notify_one();
+		m_thread.join();
+
+		delete [] m_slots;
+	}
+
+	void AsyncLogWriter::push( Log& log, std::time_t time, const String& message )
+	{
+		if( boost::this_thread::get_id() == m_thread.get_id() )
+		{
+			// logged while writing a message : waiting for room in the queue would never end
+			log.write( time, message );
+			log.flush();
+			return;
+		}
+
+		std::size_t position = m_pushPosition.load( boost::memory_order_relaxed );
+		Slot* slot = nullptr;
+
+		while( true )
+		{
+			slot = &m_slots[ position & m_mask ];
+			const std::size_t sequence = slot->sequence.load( boost::memory_order_acquire );
+
+			if( sequence == position )
+			{
+				// the slot is free : take it
+				if( m_pushPosition.compare_exchange_weak( position, position + 1, boost::memory_order_relaxed ) ) break;
+			}
+			else if( static_cast< std::ptrdiff_t >( sequence - position ) < 0 )
+			{
+				// the queue is full
+				if( m_overflowPolicy != LOP_BLOCK )
+				{
+					++m_droppedCount;
+					return;
+				}
+
+				wakeWriter();
+				boost::this_thread::yield();
+				position = m_pushPosition.load( boost::memory_order_relaxed );
+			}
+			else
+			{
+				// another thread took the slot
+				position = m_pushPosition.load( boost::memory_order_relaxed );
+			}
+		}
+
+		slot->log = &log;
+		slot->time = time;
+		slot->message = message;
+		slot->sequence.store( position + 1, boost::memory_order_release ); // ready to be written
+
+		++m_pushedCount;
+
+		wakeWriter();
+	}
+
+	void AsyncLogWriter::wakeWriter()
+	{
+		// make sure the writer will see the message if it is not sleeping yet
+		boost::atomic_thread_fence( boost::memory_order_seq_cst );
+
+		if( m_isWriterSleeping.load() )
+		{
+			boost::mutex::scoped_lock lock( m_mutex );
+			m_wakeCondition.notify_one();
+		}
+	}
+
+	void AsyncLogWriter::flush()
+	{
+		flushFor( boost::posix_time::pos_infin );
+	}
+
+	bool AsyncLogWriter::flushFor( const boost::posix_time::time_duration& timeout )
+	{
+		const unsigned long pushedCount = m_pushedCount.load();
+
+		if( boost::this_thread::get_id() == m_thread.get_id() )
+		{
+			// we are the writer thread : nobody else will write them,
+			// but the slot being written is not released yet if we are called while writing it
+			if( m_isWriting ) return false;
+			writeMessages();
+			return true;
+		}
+
+		boost::mutex::scoped_lock lock( m_mutex );
+		m_wakeCondition.notify_one();
+
+		if( timeout.is_pos_infinity() )
+		{
+			while( m_writtenCount < pushedCount ) m_writtenCondition.wait( lock );
+			return true;
+		}
+
+		const boost::system_time deadline = boost::get_system_time() + timeout;
+		while( m_writtenCount < pushedCount )
+		{
+			if( !m_writtenCondition.timed_wait( lock, deadline ) ) return m_writtenCount >= pushedCount;
+		}
+		return true;
+	}
+
+	void AsyncLogWriter::writerLoop()
+	{
+		while( true )
+		{
+			// messages pushed before the stop request are written before stopping
+			const bool isStopping = m_stop.load();
+
+			if( writeMessages() > 0 ) continue;
+			if( isStopping ) return;
+
+			// nothing to write : sleep until a message is pushed
+			boost::mutex::scoped_lock lock( m_mutex );
+			m_isWriterSleeping = true;
+
+			const Slot& nextSlot = m_slots[ m_writePosition & m_mask ];
+			if( !m_stop && nextSlot.sequence.load( boost::memory_order_acquire ) != m_writePosition + 1 )
+			{
+				// the timeout is a safety net only
+				m_wakeCondition.timed_wait( lock, boost::posix_time::milliseconds( 100 ) );
+			}
+
+			m_isWriterSleeping = false;
+		}
+	}
+
+	std::size_t AsyncLogWriter::writeMessages()
+	{
+		// not reset if a write throws : the exception terminates the application and the slot is never released
+		m_isWriting = true;
+
+		std::vector< Log* > writtenLogs;
+		std::size_t writtenCount = 0;
+
+		// stop after a full queue : flush even if the logging threads keep the queue busy
+		while( writtenCount <= m_mask )
+		{
+			Slot& slot = m_slots[ m_writePosition & m_mask ];
+			if( slot.sequence.load( boost::memory_order_acquire ) != m_writePosition + 1 ) break;
+
+			Log& log = *slot.log;
+
+			if( m_overflowPolicy == LOP_COUNT )
+			{
+				const unsigned long droppedCount = m_droppedCount.load();
+				if( droppedCount != m_reportedDroppedCount )
+				{
+					StringStream report;
+					report << droppedCount - m_reportedDroppedCount << " log messages dropped : the log queue was full!";
+					log.write( slot.time, report.str() );
+					m_reportedDroppedCount = droppedCount;
+				}
+			}
+
+			log.write( slot.time, slot.message );
+			if( std::find( writtenLogs.begin(), writtenLogs.end(), &log ) == writtenLogs.end() ) writtenLogs.push_back( &log );
+
+			// release the slot for the logging threads
+			String().swap( slot.message );
+			slot.log = nullptr;
+			slot.sequence.store( m_writePosition + m_mask + 1, boost::memory_order_release );
+			++m_writePosition;
+			++writtenCount;
+		}
+
+		if( writtenCount > 0 )
+		{
+			// one flush by batch
+			for( std::size_t i = 0; i < writtenLogs.size(); ++i )
+			{
+				writtenLogs[i]->flush();
+			}
+
+			boost::mutex::scoped_lock lock( m_mutex );
+			m_writtenCount += static_cast< unsigned long >( writtenCount );
+			m_writtenCondition.notify_all();
+		}
+
+		m_isWriting = false;
+		return writtenCount;
+	}
+
+	void AsyncLogWriter::onTerminate()
+	{
+		// don't wait for a thread that crashed while holding the registry
+		boost::mutex::scoped_try_lock lock( writerRegistryMutex() );
+		if( lock.owns_lock() )
+		{
+			const std::vector< AsyncLogWriter* >& registry = writerRegistry();
+			for( std::size_t i = 0; i < registry.size(); ++i )
+			{
+				registry[i]->flushFor( boost::posix_time::seconds( 1 ) );
+			}
+		}
+
+		if( previousTerminateHandler != nullptr ) previousTerminateHandler();
+		std::abort();
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,165 @@
+#ifndef GCORE_ASYNCLOGWRITER_H
+#define GCORE_ASYNCLOGWRITER_H
+#pragma once
+
+#include <ctime>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/atomic.hpp>
+
+#include "GC_Common.h"
+#include "GC_String.h"
+
+namespace gcore
+{
+	class Log;
+
+	/// What to do with a message logged while the queue of an AsyncLogWriter is full.
+	enum LogOverflowPolicy
+	{
+		/// Wait until the writer thread made some room in the queue.
+		LOP_BLOCK = 0,
+
+		/// Drop the message : only AsyncLogWriter::droppedMessageCount() will tell.
+		LOP_DROP,
+
+		/// Drop the message and write how many messages have been dropped in the log once there is room again.
+		LOP_COUNT,
+
+	};
+
+	/** Write the messages of Logs in a dedicated thread.
+		The logging threads only copy the messages in a bounded lock-free queue :
+		the writer thread format them, echo them on the console and write them in the log
+		files, flushing the files once by batch of messages.
+		@par
+		All the messages are written before the writer is destroyed. The remaining messages are
+		also written if the application terminates because of an unhandled exception (std::terminate).
+		@remark Created by LogManager::enableAsyncWriting.
+		@see LogManager
+	*/
+	class GCORE_API AsyncLogWriter
+	{
+	public:
+
+		/** Constructor : start the writer thread.
+			@param queueCapacity Maximum number of messages waiting to be written, rounded up to a power of 2.
+			@param overflowPolicy What to do with the messages logged while the queue is full.
+		*/
+		AsyncLogWriter( std::size_t queueCapacity, LogOverflowPolicy overflowPolicy );
+
+		/** Destructor : write the remaining messages and stop the writer thread.
+		*/
+		~AsyncLogWriter();
+
+		/** Queue a message to write in a Log.
+			@remark Can be called by any thread. When called by the writer thread, the message is written directly.
+			@param log Log to write the message in.
+			@param time Time the message was logged.
+			@param message Message to write.
+		*/
+		void push( Log& log, std::time_t time, const String& message );
+
+		/** Wait until all the messages queued before this call are written and the files flushed.
+			@remark Called by the writer thread while it is writing, it returns without waiting.
+		*/
+		void flush();
+
+		/// Maximum number of messages waiting to be written.
+		std::size_t queueCapacity() const { return m_mask + 1; }
+
+		/// What to do with the messages logged while the queue is full.
+		LogOverflowPolicy overflowPolicy() const { return m_overflowPolicy; }
+
+		/// Number of messages dropped because the queue was full.
+		unsigned long droppedMessageCount() const { return m_droppedCount.load(); }
+
+	private:
+
+		/// Slot of the message queue.
+		struct Slot
+		{
+			/// Position of the message that can be pushed in this slot, or this position + 1 if it is ready to be written.
+			boost::atomic< std::size_t > sequence;
+
+			Log* log;
+			std::time_t time;
+			String message;
+		};
+
+		/// Message queue : ring buffer of slots.
+		Slot* m_slots;
+
+		/// Capacity of the queue - 1 : the capacity is a power of 2.
+		const std::size_t m_mask;
+
+		/// What to do with the messages logged while the queue is full.
+		const LogOverflowPolicy m_overflowPolicy;
+
+		/// Position of the next message to push, modified by the logging threads.
+		boost::atomic< std::size_t > m_pushPosition;
+
+		/// Position of the next message to write, modified by the writer thread only.
+		std::size_t m_writePosition;
+
+		/// Number of messages pushed.
+		boost::atomic< unsigned long > m_pushedCount;
+
+		/// Number of messages written and flushed.
+		unsigned long m_writtenCount;
+
+		/// Number of messages dropped because the queue was full.
+		boost::atomic< unsigned long > m_droppedCount;
+
+		/// Number of dropped messages already reported in the logs.
+		unsigned long m_reportedDroppedCount;
+
+		/// True while the writer thread is waiting for messages.
+		boost::atomic< bool > m_isWriterSleeping;
+
+		/// True when the writer thread have to stop.
+		boost::atomic< bool > m_stop;
+
+		/// True while the writer thread is in writeMessages(), used by the writer thread only.
+		bool m_isWriting;
+
+		/// Mutex used with the conditions to sleep.
+		boost::mutex m_mutex;
+
+		/// Notified when there is messages to write or the writer is stopping.
+		boost::condition_variable m_wakeCondition;
+
+		/// Notified when a batch of messages has been written.
+		boost::condition_variable m_writtenCondition;
+
+		/// The writer thread.
+		boost::thread m_thread;
+
+		/// Main loop of the writer thread.
+		void writerLoop();
+
+		/// Write all the messages available in the queue. @return The number of messages written.
+		std::size_t writeMessages();
+
+		/// Wake up the writer thread if it is sleeping.
+		void wakeWriter();
+
+		/** Wait until all the messages queued before this call are written, or until the timeout.
+			When called by the writer thread, write them directly unless it is already writing them.
+			@return True if all the messages have been written.
+		*/
+		bool flushFor( const boost::posix_time::time_duration& timeout );
+
+		/// Flush all the writers when the application terminates.
+		static void onTerminate();
+
+		// non copyable
+		AsyncLogWriter( const AsyncLogWriter& );
+		void operator=( const AsyncLogWriter& );
+
+	};
+
+}
+
+#endif
\ No newline at end of file
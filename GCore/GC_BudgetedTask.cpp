@@ -0,0 +1,43 @@
+#include "GC_BudgetedTask.h"
+#include "GC_TimeReferenceProvider.h"
+
+
+namespace gcore
+{
+	BudgetedTask::BudgetedTask( const TimeReferenceProvider& timeReference, TimeValue budget, TaskPriority priority /*= 0 */,const String& name /*= "" */ ) 
+		: Task( priority, name )
+		, m_timeReference( timeReference )
+		, m_budget( budget )
+		, m_isCycleEnded( false )
+		, m_lastSliceCount( 0 )
+		, m_lastExecutionTime( 0 )
+	{
+
+	}
+
+	BudgetedTask::~BudgetedTask()
+	{
+		
+	}
+
+	void BudgetedTask::onExecute()
+	{
+		const TimeValue startTime = m_timeReference.getTimeSinceStart();
+		TimeValue spentTime = 0;
+
+		m_isCycleEnded = false;
+		m_lastSliceCount = 0;
+
+		// execute slices while we have time left
+		do
+		{
+			this->execute();
+			++m_lastSliceCount;
+
+			spentTime = m_timeReference.getTimeSinceStart() - startTime;
+		}
+		while( !m_isCycleEnded && isActive() && spentTime < m_budget );
+
+		m_lastExecutionTime = spentTime;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,100 @@
+#ifndef GC_BUDGETEDTASK_H
+#define GC_BUDGETEDTASK_H
+#pragma once
+
+#include "GC_Common.h"
+#include "GC_Time.h"
+#include "GC_Task.h"
+#include "GC_ProxyTask.h"
+
+namespace gcore
+{
+	class TimeReferenceProvider;
+
+	/** Task that execute itself repeatedly each cycle until it's time budget is spent.
+		Each call to execute() should do a small slice of the work, so that background work
+		(streaming, AI, path planning...) can use a known part of each cycle without causing spikes.
+		@par
+		The slices stop for the current cycle once the budget is spent, once endCycle() is called
+		or once the Task is not active anymore. At least one slice is executed each cycle.
+	*/
+	class GCORE_API BudgetedTask 
+		: virtual public Task
+	{
+	public:
+
+		/** Constructor.
+			@see Task::Task
+			@param timeReference Time reference used to measure the time spent, must outlive this Task.
+			@param budget Time this Task can spend executing slices each cycle.
+		*/
+		BudgetedTask( const TimeReferenceProvider& timeReference, TimeValue budget, TaskPriority priority = 0 ,const String& name = "" );
+
+		/** Destructor.
+		*/
+		virtual ~BudgetedTask();
+
+		/// Time this Task can spend executing slices each cycle.
+		TimeValue budget() const { return m_budget; }
+
+		/// Change the time this Task can spend executing slices each cycle.
+		void setBudget( TimeValue budget ) { m_budget = budget; }
+
+		/** Stop executing slices until the next cycle.
+			Call it from execute() when there is no more work to do for this cycle.
+		*/
+		void endCycle() { m_isCycleEnded = true; }
+
+		/// Number of slices executed in the last cycle.
+		unsigned long lastSliceCount() const { return m_lastSliceCount; }
+
+		/// Time spent executing slices in the last cycle.
+		TimeValue lastExecutionTime() const { return m_lastExecutionTime; }
+
+	protected:
+
+		/** Execution behavior : here we execute the task slices until
+			the budget is spent.
+		*/
+		virtual void onExecute();
+
+	private:
+
+		/// Time reference used to measure the time spent.
+		const TimeReferenceProvider& m_timeReference;
+
+		/// Time this Task can spend executing slices each cycle.
+		TimeValue m_budget;
+
+		/// True when no more slice have to be executed this cycle.
+		bool m_isCycleEnded;
+
+		/// Number of slices executed in the last cycle.
+		unsigned long m_lastSliceCount;
+
+		/// Time spent executing slices in the last cycle.
+		TimeValue m_lastExecutionTime;
+
+	};
+
+#pragma warning( push )
+#pragma warning( disable : 4250 ) // we want to use ProxyTask definitions, yes..
+
+	class BudgetedProxyTask 
+		: public ProxyTask
+		, public BudgetedTask
+	{ 
+	public:
+		BudgetedProxyTask( const TaskFunction& executeFunction, const TimeReferenceProvider& timeReference, TimeValue budget
+			, const TaskFunction& onActivateFunction = &ProxyTask::emptyFunction, const TaskFunction& onTerminateFunction = &ProxyTask::emptyFunction
+			, const TaskFunction& onPausedFunction = &ProxyTask::emptyFunction, const TaskFunction& onResumedFunction = &ProxyTask::emptyFunction
+			, TaskPriority priority = 0, const String& name = "" ) 
+			: BudgetedTask( timeReference, budget, priority, name )
+			, ProxyTask( executeFunction, onActivateFunction, onTerminateFunction, onPausedFunction, onResumedFunction, priority, name )
+		{}
+	};
+#pragma warning( pop )
+
+}
+
+#endif
\ No newline at end of file
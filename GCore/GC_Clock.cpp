@@ -1,7 +1,5 @@
 #include "GC_Clock.h"
 
-#include <cmath>
-
 namespace gcore
 {
 
@@ -9,13 +7,10 @@ namespace gcore
 	/** Construtor.
 	@param name Clock's name.
 	*/
-	Clock::Clock(const String& name, ClockManager& clockManager)
+	Clock::Clock(const String& name, ClockManager& clockManager, std::size_t index)
 		: m_clockManager( clockManager )
 		, m_name(name)
-		, m_timeFlowFactor(1.0)
-		, m_time(0)
-		, m_deltaTime(0)
-		, m_max_deltaTime(0)
+		, m_index( index )
 	{
 
 	}
@@ -27,40 +22,13 @@ namespace gcore
 
 	}
 
-	/** Clock Update (by ClockManager)
-	@param	deltaTime Delta time value (time passed since last udpate, in seconds).
-	*/
-	void Clock::update(TimeValue deltaTime)
-	{
-		//The factor value let us speed up, slow down, inverse or stop the time flow
-		m_deltaTime = m_timeFlowFactor * deltaTime;
-
-		if( m_max_deltaTime > 0)
-		{
-			if( std::fabs( m_deltaTime ) > m_max_deltaTime )
-			{
-				if( m_deltaTime >= 0 )
-				{
-					m_deltaTime = m_max_deltaTime;
-				}
-				else
-				{
-					m_deltaTime = -m_max_deltaTime;
-				}
-			}
-		}
-
-		m_time += m_deltaTime;//update time
-
-	}
-
 	void Clock::reset()
 	{
-		m_time=0;
+		m_clockManager.m_times[ m_index ]=0;
 	}
 
 	void Clock::time( TimeValue time )
 	{
-		m_time=time;
+		m_clockManager.m_times[ m_index ]=time;
 	}
 }
\ No newline at end of file
@@ -16,9 +16,14 @@ namespace gcore
 	/** Virtual Clock.
 		
 		Own a TimeFlowFactor that allow acceleration, slow down, stop
-		and inversion of time flow, for this clock only.
+		and inversion of time flow, for this clock and it's children.
+		@par
+		A clock with a parent clock advance of the parent delta time scaled by it's own flow factor,
+		so stopping a clock stops all it's children too.
 
 		@remark Should be created , destroyed and managed by a ClockManager.
+		@remark The time data are stored in the ClockManager and are moved when the clocks
+		are created, destroyed or reordered : the accessors return them by value.
 		@see ClockManager
 	*/
 	class GCORE_API Clock
@@ -28,7 +33,7 @@ namespace gcore
 
 		/** @return Virtual seconds passed since the clock initialization.
 		 */
-		const TimeValue& time() const{ return m_time; }
+		TimeValue time() const{ return m_clockManager.m_times[ m_index ]; }
 
 		/** Virtual seconds passed since the clock initialization.
 			@param time New value.
@@ -37,27 +42,28 @@ namespace gcore
 
 		/** @return Time flow factor.
 		 */
-		const TimeFlowFactor& timeFlowFactor() const {return m_timeFlowFactor;}
+		TimeFlowFactor timeFlowFactor() const {return m_clockManager.m_flowFactors[ m_index ];}
 
 		/** Time flow factor.
 			@param	factor New flow factor value.
 		*/
-		void timeFlowFactor(TimeFlowFactor factor){m_timeFlowFactor=factor;}
+		void timeFlowFactor(TimeFlowFactor factor){m_clockManager.m_flowFactors[ m_index ]=factor;}
 
 		/** Virtual delta time (from the last update and flow factor dependent).
+			For a clock with a parent, it is the parent delta time scaled by the flow factor of this clock.
 		*/
-		const TimeValue& deltaTime() const { return m_deltaTime;}
+		TimeValue deltaTime() const { return m_clockManager.m_deltaTimes[ m_index ];}
 
 		/** @return Maximum virtual time elapsed or 0 or negative value if no limit set (default).                                                                     
 		*/
-		TimeValue maxDeltaTime() const { return m_max_deltaTime; }
+		TimeValue maxDeltaTime() const { return m_clockManager.m_maxDeltaTimes[ m_index ]; }
 		
 		/** Set a maximum limit to the possible virtual delta time or 0 or negative value for no limit (default).
 		*/
 		void maxDeltaTime( TimeValue maxDeltaTime )
 		{
 			GC_ASSERT( maxDeltaTime >= 0, "Max delta time have to be 0 or positive!");
-			m_max_deltaTime = maxDeltaTime;
+			m_clockManager.m_maxDeltaTimes[ m_index ] = maxDeltaTime;
 		}
 		
 		/** Reset Time to 0 seconds elapsed.
@@ -68,6 +74,14 @@ namespace gcore
 		*/
 		const String& name() const {return m_name;}
 
+		/** @return Parent clock which delta time this clock scales, or null if this clock follows the ClockManager time.
+		*/
+		Clock* parent() const 
+		{ 
+			const std::size_t parentIndex = m_clockManager.m_parentIndices[ m_index ];
+			return parentIndex != ClockManager::INVALID_INDEX ? m_clockManager.m_clockList[ parentIndex ] : nullptr;
+		}
+
 		/** @copydoc m_clockManager */
 		const ClockManager& clockManager() const { return m_clockManager; }
 		ClockManager& clockManager() { return m_clockManager; }
@@ -82,29 +96,16 @@ namespace gcore
 		/// Clock's name.
 		String m_name;
 
-		/// Virtual seconds passed since the clock initialization.
-		TimeValue m_time;
-
-		/// Time flow factor.
-		TimeFlowFactor m_timeFlowFactor;
+		/// Index of the data of this clock in the clock manager.
+		std::size_t m_index;
 
-		/// Virtual delta time (from the last update and flow factor dependent).
-		TimeValue m_deltaTime;
-
-		/// Maximum time elapsed allowed, or 0 or negative value if no limit set.
-		TimeValue m_max_deltaTime;
-
-
-		/** Clock Update (by ClockManager)
-			@param	deltaTime Delta time value (time passed since last update, in seconds).
-		 */
-		void update(TimeValue deltaTime);
 
 		/** Constructor.
 			@param name Clock's name.
 			@param clockmanager Clock manager that created, manage and will destroy this Clock.
+			@param index Index of the data of this clock in the clock manager.
 		*/
-		Clock(const String& name, ClockManager& clockManager );
+		Clock(const String& name, ClockManager& clockManager, std::size_t index );
 		
 		/** Destructor.
 		*/
@@ -0,0 +1,167 @@
+#ifndef GCORE_CLOCKDATAMAP_H
+#define GCORE_CLOCKDATAMAP_H
+#pragma once
+
+#include <vector>
+#include <utility>
+#include <unordered_map>
+
+#include "GC_Common.h"
+#include "GC_Clock.h"
+#include "GC_ClockManager.h"
+
+namespace gcore
+{
+	/** Data associated to Clocks, destroyed with their Clock.
+
+		The data of a Clock is created on demand. While it holds the data of at least one Clock
+		of a ClockManager, the map listens to this ClockManager to destroy the data of the destroyed Clocks.
+		The Clocks can be managed by different ClockManagers.
+		@par
+		DataType must be constructible from the const Clock& it is associated to.
+		@remark Derived classes can override onClockDataDestroyed() to be notified when a Clock with data is destroyed.
+	*/
+	template< class DataType >
+	class ClockDataMap : private ClockManager::Listener
+	{
+	public:
+
+		typedef std::tr1::unordered_map< const Clock*, DataType* > Index;
+		typedef typename Index::iterator iterator;
+		typedef typename Index::const_iterator const_iterator;
+
+		ClockDataMap() {}
+
+		/** Destructor : destroy the data of all the clocks.
+		*/
+		virtual ~ClockDataMap() { clear(); }
+
+		/** @return Data of the clock, or null if it has no data.
+		*/
+		DataType* find( const Clock& clock ) const
+		{
+			const_iterator it = m_index.find( &clock );
+			return it != m_index.end() ? it->second : nullptr;
+		}
+
+		/** @return Data of the clock, created if it has no data yet.
+		*/
+		DataType& findOrCreate( const Clock& clock )
+		{
+			iterator it = m_index.find( &clock );
+			if( it != m_index.end() ) return *it->second;
+
+			// the clock manager is not modified, only watched
+			ClockManager& clockManager = const_cast< ClockManager& >( clock.clockManager() );
+			std::size_t managerIdx = 0;
+			while( managerIdx < m_clockManagers.size() && m_clockManagers[ managerIdx ].first != &clockManager ) ++managerIdx;
+			if( managerIdx == m_clockManagers.size() )
+			{
+				clockManager.registerListener( this );
+				m_clockManagers.push_back( std::make_pair( &clockManager, std::size_t( 0 ) ) );
+			}
+
+			DataType* data = new DataType( clock );
+			try
+			{
+				m_index.insert( std::make_pair( &clock, data ) );
+			}
+			catch( ... )
+			{
+				delete data;
+				if( m_clockManagers[ managerIdx ].second == 0 )
+				{
+					clockManager.unregisterListener( this );
+					m_clockManagers.erase( m_clockManagers.begin() + managerIdx );
+				}
+				throw;
+			}
+
+			++m_clockManagers[ managerIdx ].second;
+			return *data;
+		}
+
+		/** Destroy the data of a clock, if any.
+		*/
+		void destroy( const Clock& clock )
+		{
+			iterator it = m_index.find( &clock );
+			if( it != m_index.end() ) destroy( it );
+		}
+
+		/** Destroy the data of a clock.
+			@param it Valid iterator of this map.
+		*/
+		void destroy( iterator it )
+		{
+			DataType* data = it->second;
+			const Clock& clock = *it->first;
+			m_index.erase( it );
+
+			ClockManager* clockManager = const_cast< ClockManager* >( &clock.clockManager() );
+			for( std::size_t i = 0; i < m_clockManagers.size(); ++i )
+			{
+				if( m_clockManagers[i].first != clockManager ) continue;
+
+				if( --m_clockManagers[i].second == 0 )
+				{
+					clockManager->unregisterListener( this );
+					m_clockManagers.erase( m_clockManagers.begin() + i );
+				}
+				break;
+			}
+
+			delete data;
+		}
+
+		/** Destroy the data of all the clocks.
+		*/
+		void clear()
+		{
+			while( !m_index.empty() )
+			{
+				destroy( m_index.begin() );
+			}
+		}
+
+		bool empty() const { return m_index.empty(); }
+		std::size_t size() const { return m_index.size(); }
+
+		iterator begin() { return m_index.begin(); }
+		iterator end() { return m_index.end(); }
+		const_iterator begin() const { return m_index.begin(); }
+		const_iterator end() const { return m_index.end(); }
+
+	protected:
+
+		/** Called when a clock with data is destroyed, just before it's data is destroyed.
+			@param data Data of the destroyed clock.
+		*/
+		virtual void onClockDataDestroyed( DataType& /*data*/ ) { ; }
+
+	private:
+
+		/// Data of each clock.
+		Index m_index;
+
+		/// Clock managers this is registered in, with the number of their clocks with data.
+		std::vector< std::pair< ClockManager*, std::size_t > > m_clockManagers;
+
+		void onClockDestroyed( Clock& clock )
+		{
+			DataType* data = find( clock );
+			if( data == nullptr ) return;
+
+			onClockDataDestroyed( *data );
+			destroy( clock );
+		}
+
+		// non copyable
+		ClockDataMap( const ClockDataMap& );
+		void operator=( const ClockDataMap& );
+
+	};
+
+}
+
+#endif
\ No newline at end of file
@@ -1,6 +1,10 @@
 #include "GC_ClockManager.h"
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
+#include <new>
+#include <boost/pool/pool.hpp>
 
 #include "GC_Clock.h"
 
@@ -12,11 +16,28 @@ namespace gcore
 	*/
 	ClockManager::ClockManager(const TimeReferenceProvider& timeReference, size_t reserveClockCount )
 		: m_timeReference(timeReference)
+		, m_clockPool( nullptr )
+		, m_isSortNeeded( false )
 		, m_deltaTime( 0 )
 		, m_lastUpdateTime( timeReference.getTimeSinceStart() )
 		, m_max_deltaTime( 0 )
+		, m_fixedStep( 0 )
+		, m_maxFixedSubstepCount( 5 )
+		, m_maxLateFixedSubstepCount( 0 )
+		, m_fixedStepTime( 0 )
+		, m_fixedSubstepCount( 0 )
+		, m_fixedStepAlpha( 0 )
+		, m_fixedStepDroppedTime( 0 )
 	{
-		
+		m_clockPool = new ClockPool( sizeof( Clock ), reserveClockCount > 0 ? reserveClockCount : 32 );
+
+		m_clockList.reserve( reserveClockCount );
+		m_times.reserve( reserveClockCount );
+		m_flowFactors.reserve( reserveClockCount );
+		m_deltaTimes.reserve( reserveClockCount );
+		m_maxDeltaTimes.reserve( reserveClockCount );
+		m_parentIndices.reserve( reserveClockCount );
+		m_sourceDeltaTimes.reserve( reserveClockCount );
 	}
 
 	/** Destructor.
@@ -25,6 +46,8 @@ namespace gcore
 	{
 		if(!m_clockList.empty())
 			destroyAllClocks();
+
+		delete m_clockPool;
 	}
 
 
@@ -34,7 +57,7 @@ namespace gcore
 		@param name Name given to the Clock object.
 		@return A pointer to the new Clock object.
 	*/
-	Clock* ClockManager::createClock(const String& name)
+	Clock* ClockManager::createClock(const String& name, Clock* parent )
 	{
 		if( m_clockIndex.find(name)!=m_clockIndex.end())
 		{
@@ -42,15 +65,65 @@ namespace gcore
 			GC_EXCEPTION << "Tried to create a Clock with a name already registered!";
 		}
 
-		//create the clock
-		Clock* clock = new Clock(name, (*this) );
+		std::size_t parentIndex = INVALID_INDEX;
+		if( parent != nullptr )
+		{
+			if( &parent->m_clockManager != this )
+			{
+				GC_EXCEPTION << "Tried to create a Clock with a parent that was not created by this manager! Parent name : " << parent->name();
+			}
+			parentIndex = parent->m_index;
+		}
+
+		//create the clock, it's data at the end : after it's parent
+		const std::size_t clockIndex = m_clockList.size();
+		void* clockMemory = m_clockPool->malloc();
+		if( clockMemory == nullptr ) throw std::bad_alloc();
+		Clock* clock = new( clockMemory ) Clock(name, (*this), clockIndex );
+
+		try
+		{
+			m_clockList.push_back(clock);
+			m_times.push_back( 0 );
+			m_flowFactors.push_back( 1.0 );
+			m_deltaTimes.push_back( 0 );
+			m_maxDeltaTimes.push_back( 0 );
+			m_parentIndices.push_back( parentIndex );
+			m_sourceDeltaTimes.push_back( 0 );
+		}
+		catch( ... )
+		{
+			// keep the data arrays the same size
+			m_clockList.resize( clockIndex );
+			m_times.resize( clockIndex );
+			m_flowFactors.resize( clockIndex );
+			m_deltaTimes.resize( clockIndex );
+			m_maxDeltaTimes.resize( clockIndex );
+			m_parentIndices.resize( clockIndex );
+			m_sourceDeltaTimes.resize( clockIndex );
+			deleteClock( clock );
+			throw;
+		}
 
 		//register it's name if necessary
 		if(name != "")
 			m_clockIndex[name] = clock;
 
-		//register the clock for future updates
-		m_clockList.push_back(clock);
+		//keep the clocks ordered by depth
+		if( !m_isSortNeeded )
+		{
+			const std::size_t depth = parentIndex == INVALID_INDEX ? 0 : std::upper_bound( m_depthEnds.begin(), m_depthEnds.end(), parentIndex ) - m_depthEnds.begin() + 1;
+			if( depth + 1 >= m_depthEnds.size() )
+			{
+				// deepest clock : already at it's place
+				m_depthEnds.resize( depth + 1, clockIndex );
+				m_depthEnds[ depth ] = clockIndex + 1;
+			}
+			else
+			{
+				m_isSortNeeded = true; // sorted once on the next update
+			}
+		}
 
 		return clock;
 	}
@@ -65,30 +138,47 @@ namespace gcore
 		GC_ASSERT( clock != nullptr, "Tried to destroy a null clock!" );
 		GC_ASSERT( std::count( m_clockList.begin(), m_clockList.end(), clock ) == 1 , String( "Tried to destroy a clock that was not created by this manager! Clock name : ") + clock->name() );
 
-		for(ClockList::iterator it= m_clockList.begin(); it != m_clockList.end(); ++it)
+		const std::size_t clockIndex = clock->m_index;
+		GC_ASSERT( clockIndex < m_clockList.size() && m_clockList[ clockIndex ] == clock, "Clock index is invalid!" );
+
+		notifyClockDestroyed( *clock );
+
+		//unregister
+		m_clockIndex.erase( clock->name() );
+
+		//the children follow the parent of the clock
+		const std::size_t parentIndex = m_parentIndices[ clockIndex ];
+		const std::size_t clockCount = m_clockList.size();
+		for( std::size_t i = clockIndex + 1; i < clockCount; ++i )
 		{
-			Clock* registeredClock = (*it);
-			GC_ASSERT_NOT_NULL( registeredClock );
+			if( m_parentIndices[i] == clockIndex ) m_parentIndices[i] = parentIndex;
+		}
 
-			if( registeredClock == clock )
-			{
-				//Found!
-				//unregister
-				m_clockList.erase(it);
-				m_clockIndex.erase( clock->name() );
-				
-				//destroy
-				delete clock;
-
-				return;
-			}
+		//remove it's data, the clocks after it move back
+		m_clockList.erase( m_clockList.begin() + clockIndex );
+		m_times.erase( m_times.begin() + clockIndex );
+		m_flowFactors.erase( m_flowFactors.begin() + clockIndex );
+		m_deltaTimes.erase( m_deltaTimes.begin() + clockIndex );
+		m_maxDeltaTimes.erase( m_maxDeltaTimes.begin() + clockIndex );
+		m_parentIndices.erase( m_parentIndices.begin() + clockIndex );
+		m_sourceDeltaTimes.pop_back();
+
+		for( std::size_t i = clockIndex; i < m_clockList.size(); ++i )
+		{
+			m_clockList[i]->m_index = i;
+			if( m_parentIndices[i] != INVALID_INDEX && m_parentIndices[i] > clockIndex ) --m_parentIndices[i];
 		}
 
-		GC_ASSERT( false, "Clock not found! - Previous checks failed!" );
+		//children depth changed, sorted once on the next update
+		m_isSortNeeded = true;
+
+		//destroy
+		deleteClock( clock );
  
 	}
 
 
+
 	/** Destroy all Clocks created by this ClockManager.
 		This will make all pointers to those Clock objects invalid!
 	*/
@@ -99,15 +189,54 @@ namespace gcore
 		{
 			Clock* clock = *it;
 			GC_ASSERT( clock != nullptr, "Found a null clock in the clock list!" );
-			delete clock;
+			notifyClockDestroyed( *clock );
+			deleteClock( clock );
 		}
 
 		//unregister all clocks
 		m_clockList.clear();
+		m_times.clear();
+		m_flowFactors.clear();
+		m_deltaTimes.clear();
+		m_maxDeltaTimes.clear();
+		m_parentIndices.clear();
+		m_sourceDeltaTimes.clear();
+		m_depthEnds.clear();
+		m_isSortNeeded = false;
 		m_clockIndex.clear();
 
 	}
 
+	void ClockManager::registerListener( Listener* listener )
+	{
+		GC_ASSERT( listener != nullptr, "Tried to register a null listener in a clock manager!" );
+		GC_ASSERT( std::find( m_listenerList.begin(), m_listenerList.end(), listener ) == m_listenerList.end(), "Tried to register an already registered listener in a clock manager!" );
+
+		m_listenerList.push_back( listener );
+	}
+
+	void ClockManager::unregisterListener( Listener* listener )
+	{
+		std::vector< Listener* >::iterator it = std::find( m_listenerList.begin(), m_listenerList.end(), listener );
+		GC_ASSERT( it != m_listenerList.end(), "Tried to unregister a non registered listener from a clock manager!" );
+
+		if( it != m_listenerList.end() )
+		{
+			m_listenerList.erase( it );
+		}
+	}
+
+	void ClockManager::notifyClockDestroyed( Clock& clock )
+	{
+		// copy : listeners can unregister themselves when notified
+		const std::vector< Listener* > listeners( m_listenerList );
+		for( std::vector< Listener* >::const_iterator it = listeners.begin(); it != listeners.end(); ++it )
+		{
+			GC_ASSERT_NOT_NULL( *it );
+			(*it)->onClockDestroyed( clock );
+		}
+	}
+
 	/** Get a Clock by it's name.
 	@param name Clock's name (given at it's creation).
 	@return A pointer to the Clock or nullptr if not found.
@@ -141,14 +270,30 @@ namespace gcore
 			m_deltaTime = std::min< TimeValue >( m_deltaTime, m_max_deltaTime ); // take the lowest delta time 
 		}
 
-		//update clocks
-		for (ClockList::iterator it = m_clockList.begin(); it != m_clockList.end(); ++it )
+		if( m_fixedStep > 0 ) advanceFixedStep();
+
+		if( m_isSortNeeded ) sortClocks();
+
+		//update clocks, one depth after the other : the parents are updated before their children
+		std::size_t depthBegin = 0;
+		const std::size_t depthCount = m_depthEnds.size();
+		for( std::size_t depth = 0; depth < depthCount; ++depth )
 		{
-			Clock* clock = (*it);
-			GC_ASSERT_NOT_NULL( clock );
+			const std::size_t depthEnd = m_depthEnds[ depth ];
+			if( depth == 0 )
+			{
+				std::fill( m_sourceDeltaTimes.begin(), m_sourceDeltaTimes.begin() + depthEnd, m_deltaTime );
+			}
+			else
+			{
+				for( std::size_t i = depthBegin; i < depthEnd; ++i )
+				{
+					m_sourceDeltaTimes[i] = m_deltaTimes[ m_parentIndices[i] ];
+				}
+			}
 
-			clock->update(m_deltaTime);
-						
+			advanceClocks( depthBegin, depthEnd );
+			depthBegin = depthEnd;
 		}
 		//save the last update time
 		m_lastUpdateTime = timeValue;
@@ -156,16 +301,130 @@ namespace gcore
 
 	void ClockManager::reset()
 	{
-		for (ClockList::iterator it = m_clockList.begin(); it != m_clockList.end(); ++it )
+		std::fill( m_times.begin(), m_times.end(), 0 );
+
+		m_lastUpdateTime = m_timeReference.getTimeSinceStart();
+		m_deltaTime = 0;
+
+		m_fixedStepTime = 0;
+		m_fixedSubstepCount = 0;
+		m_fixedStepAlpha = 0;
+		m_fixedStepDroppedTime = 0;
+	}
+
+	void ClockManager::setFixedStep( TimeValue fixedStep, unsigned int maxSubstepCount /*= 5*/, unsigned int maxLateSubstepCount /*= 0*/ )
+	{
+		GC_ASSERT( fixedStep >= 0, "Fixed step have to be 0 or positive!" );
+		GC_ASSERT( fixedStep == 0 || maxSubstepCount > 0, "Tried to enable the fixed-step mode without allowing any step by update!" );
+
+		m_fixedStep = fixedStep;
+		m_maxFixedSubstepCount = maxSubstepCount;
+		m_maxLateFixedSubstepCount = maxLateSubstepCount;
+
+		m_fixedStepTime = 0;
+		m_fixedSubstepCount = 0;
+		m_fixedStepAlpha = 0;
+		m_fixedStepDroppedTime = 0;
+	}
+
+	void ClockManager::advanceFixedStep()
+	{
+		m_fixedStepTime += m_deltaTime;
+
+		// counts are computed as time values : a huge delta time can't overflow
+		const TimeValue dueCount = std::floor( m_fixedStepTime / m_fixedStep );
+		const TimeValue keptCount = std::min( dueCount, static_cast< TimeValue >( m_maxFixedSubstepCount ) + m_maxLateFixedSubstepCount );
+		const TimeValue executedCount = std::min( keptCount, static_cast< TimeValue >( m_maxFixedSubstepCount ) );
+
+		// spiral of death guard : drop the steps we will not catch up
+		m_fixedStepDroppedTime = ( dueCount - keptCount ) * m_fixedStep;
+		m_fixedSubstepCount = static_cast< unsigned int >( executedCount );
+
+		// keep the late steps and the time since the last step
+		m_fixedStepTime = std::max< TimeValue >( m_fixedStepTime - dueCount * m_fixedStep, 0 ) + ( keptCount - executedCount ) * m_fixedStep;
+		m_fixedStepAlpha = std::min< TimeValue >( m_fixedStepTime / m_fixedStep, 1 );
+	}
+
+	void ClockManager::advanceClocks( std::size_t begin, std::size_t end )
+	{
+		if( begin == end ) return;
+
+		// raw pointers on the data : no aliasing, the loop can be vectorized
+		TimeValue* times = &m_times[0];
+		TimeValue* deltaTimes = &m_deltaTimes[0];
+		const TimeFlowFactor* flowFactors = &m_flowFactors[0];
+		const TimeValue* maxDeltaTimes = &m_maxDeltaTimes[0];
+		const TimeValue* sourceDeltaTimes = &m_sourceDeltaTimes[0];
+		const TimeValue noLimit = std::numeric_limits< TimeValue >::max();
+
+		for( std::size_t i = begin; i < end; ++i )
 		{
-			Clock* clock = (*it);
-			GC_ASSERT_NOT_NULL( clock );
+			//The factor value let us speed up, slow down, inverse or stop the time flow
+			const TimeValue limit = maxDeltaTimes[i] > 0 ? maxDeltaTimes[i] : noLimit;
+			const TimeValue deltaTime = std::min( std::max( flowFactors[i] * sourceDeltaTimes[i], -limit ), limit );
 
-			clock->reset();
+			deltaTimes[i] = deltaTime;
+			times[i] += deltaTime; //update time
 		}
+	}
 
-		m_lastUpdateTime = m_timeReference.getTimeSinceStart();
-		m_deltaTime = 0;
+	void ClockManager::sortClocks()
+	{
+		const std::size_t clockCount = m_clockList.size();
+
+		// depth of each clock : the parents are before their children
+		std::vector< std::size_t > depths( clockCount );
+		m_depthEnds.clear();
+		for( std::size_t i = 0; i < clockCount; ++i )
+		{
+			const std::size_t parentIndex = m_parentIndices[i];
+			GC_ASSERT( parentIndex == INVALID_INDEX || parentIndex < i, "Found a clock before it's parent!" );
+
+			depths[i] = parentIndex == INVALID_INDEX ? 0 : depths[ parentIndex ] + 1;
+			if( depths[i] >= m_depthEnds.size() ) m_depthEnds.resize( depths[i] + 1, 0 );
+			++m_depthEnds[ depths[i] ];
+		}
+
+		// counting sort by depth, stable
+		std::vector< std::size_t > depthPositions( m_depthEnds.size(), 0 );
+		for( std::size_t depth = 1; depth < m_depthEnds.size(); ++depth )
+		{
+			m_depthEnds[ depth ] += m_depthEnds[ depth - 1 ];
+			depthPositions[ depth ] = m_depthEnds[ depth - 1 ];
+		}
+
+		std::vector< std::size_t > newIndices( clockCount );
+		for( std::size_t i = 0; i < clockCount; ++i )
+		{
+			newIndices[i] = depthPositions[ depths[i] ]++;
+		}
+
+		m_isSortNeeded = false;
+
+		// move the data
+		const ClockList clockList( m_clockList );
+		const std::vector< TimeValue > times( m_times );
+		const std::vector< TimeFlowFactor > flowFactors( m_flowFactors );
+		const std::vector< TimeValue > deltaTimes( m_deltaTimes );
+		const std::vector< TimeValue > maxDeltaTimes( m_maxDeltaTimes );
+		const std::vector< std::size_t > parentIndices( m_parentIndices );
 
+		for( std::size_t i = 0; i < clockCount; ++i )
+		{
+			const std::size_t newIndex = newIndices[i];
+			m_clockList[ newIndex ] = clockList[i];
+			m_times[ newIndex ] = times[i];
+			m_flowFactors[ newIndex ] = flowFactors[i];
+			m_deltaTimes[ newIndex ] = deltaTimes[i];
+			m_maxDeltaTimes[ newIndex ] = maxDeltaTimes[i];
+			m_parentIndices[ newIndex ] = parentIndices[i] == INVALID_INDEX ? INVALID_INDEX : newIndices[ parentIndices[i] ];
+			clockList[i]->m_index = newIndex;
+		}
+	}
+
+	void ClockManager::deleteClock( Clock* clock )
+	{
+		clock->~Clock();
+		m_clockPool->free( clock );
 	}
 }
\ No newline at end of file
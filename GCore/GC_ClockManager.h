@@ -4,6 +4,7 @@
 
 #include <unordered_map>
 #include <vector>
+#include <boost/pool/poolfwd.hpp>
 #include "GC_String.h"
 
 #include "GC_Common.h"
@@ -14,6 +15,12 @@ namespace gcore
 	class Clock;
 	
 	/** Create, destroy and manage Clock objects.
+		Clocks can have a parent clock : their delta time is then the parent one
+		scaled by their flow factor instead of the delta time of the manager.
+		@par
+		The time data of the clocks are stored by the manager in parallel arrays, 
+		ordered by depth in the clock hierarchy : updateClocks() process each depth 
+		in a tight loop over contiguous data. Clock objects are views on these data.
 		@remark To keep all the managed clocks updated, frequent calls of
 		updateClocks should be done.
 	*/
@@ -27,17 +34,31 @@ namespace gcore
 		/// List of clocks.
 		typedef std::vector< Clock* > ClockList;
 
+		/** Listener class that is notified when a clock of the manager it is registered in is destroyed.
+		*/
+		class Listener
+		{
+		public:
+			virtual ~Listener(){}
+
+			/** User defined behavior called just before a clock is destroyed.
+			*/
+			virtual void onClockDestroyed( Clock& clock ) = 0;
+		};
+
 		/** Create a Clock object.
 			The name of the Clock must be unique for this ClockManager,
 			if not an exception will occurs.
 			@param name Name given to the Clock.
+			@param parent Clock of this manager which delta time the new Clock will scale, or null to follow the manager time.
 			@return A pointer to the new Clock object
 		*/
-		Clock* createClock(const String& name);
+		Clock* createClock(const String& name, Clock* parent = nullptr );
 
 		/** Destroy a Clock created by this ClockManager.
 			If the Clock object was not created by this ClockManager,
 			an exception occurs.
+			@remark The children of the destroyed Clock become children of it's parent.
 			@param clock Pointer to the Clock to destroy. 
 		*/
 		void destroyClock(Clock* clock);
@@ -47,6 +68,16 @@ namespace gcore
 		*/
 		void destroyAllClocks();
 
+		/** Register a listener to notify when a Clock is destroyed.
+			@param listener Listener to register, not already registered.
+		*/
+		void registerListener( Listener* listener );
+
+		/** Unregister a listener.
+			@param listener Registered listener to unregister.
+		*/
+		void unregisterListener( Listener* listener );
+
 		/** Get a Clock by it's name.
 			@param name Clock's name (given at it's creation).
 			@return A pointer to the Clock or nullptr if not found.
@@ -85,6 +116,42 @@ namespace gcore
 			m_max_deltaTime = maxDeltaTime;
 		}
 
+		/** Enable or disable the fixed-step mode.
+			In fixed-step mode, each update accumulate the delta time and compute how many 
+			steps of fixed duration have to be executed this cycle, to run simulations 
+			(physics) at a fixed rate. Steps that could not be executed this cycle are
+			executed in the next ones, in the limit of the late steps allowed : the time of
+			the other ones is dropped, to not get slower and slower when the steps are too
+			long to execute (spiral of death).
+			@param fixedStep Duration of a step (in seconds) or 0 to disable the fixed-step mode (default).
+			@param maxSubstepCount Maximum number of steps to execute in one update.
+			@param maxLateSubstepCount Maximum number of steps kept to execute in the next updates
+				when more than maxSubstepCount steps are due.
+			@see FixedStepTask
+		*/
+		void setFixedStep( TimeValue fixedStep, unsigned int maxSubstepCount = 5, unsigned int maxLateSubstepCount = 0 );
+
+		/// Duration of a fixed step (in seconds) or 0 if the fixed-step mode is disabled.
+		TimeValue getFixedStep() const { return m_fixedStep; }
+
+		/// Maximum number of fixed steps to execute in one update.
+		unsigned int getMaxFixedSubstepCount() const { return m_maxFixedSubstepCount; }
+
+		/// Maximum number of fixed steps kept to execute in the next updates.
+		unsigned int getMaxLateFixedSubstepCount() const { return m_maxLateFixedSubstepCount; }
+
+		/// Number of fixed steps to execute for the last update.
+		unsigned int getFixedSubstepCount() const { return m_fixedSubstepCount; }
+
+		/** Position between the last fixed step and the next one, in [0,1] :
+			to interpolate the rendering of the last two simulated states.
+			@remark It is 1 when there are late steps to execute.
+		*/
+		TimeValue getFixedStepAlpha() const { return m_fixedStepAlpha; }
+
+		/// Time that was dropped by the last update because too many fixed steps were due (in seconds).
+		TimeValue getFixedStepDroppedTime() const { return m_fixedStepDroppedTime; }
+
 		/** Return the registered Clock list.
 		*/
 		const ClockList& getClockList() const {return m_clockList;}
@@ -109,18 +176,49 @@ namespace gcore
 
 	private:
 
+		/// Clock objects are views on the data of the manager.
+		friend class Clock;
+
+		typedef boost::pool<> ClockPool;
+
 		/** Provide time used as reference to update all Clocks.
 		*/
 		const TimeReferenceProvider& m_timeReference;
 
+		/// Memory of the Clock objects.
+		ClockPool* m_clockPool;
+
 		/** Named index of all the Clocks.
 		*/
 		ClockIndex m_clockIndex;
 
-		/** List of all Clocks created by this ClockManager.
+		/** List of all Clocks created by this ClockManager, ordered by depth in the hierarchy then by creation
+			after an update, and always after their parent.
 		*/
 		ClockList m_clockList;
 
+		/** @name Data of the clocks, in the order of the clock list.
+		*/
+		//@{
+		std::vector< TimeValue > m_times;
+		std::vector< TimeFlowFactor > m_flowFactors;
+		std::vector< TimeValue > m_deltaTimes;
+		std::vector< TimeValue > m_maxDeltaTimes;
+		std::vector< std::size_t > m_parentIndices; ///< INVALID_INDEX for the clocks without parent.
+		//@}
+
+		/// Delta time to scale by each clock on the current update.
+		std::vector< TimeValue > m_sourceDeltaTimes;
+
+		/// End of the clocks of each depth in the clock list.
+		std::vector< std::size_t > m_depthEnds;
+
+		/// True if clocks are not ordered by depth anymore : they are still after their parent.
+		bool m_isSortNeeded;
+
+		/// Invalid index in the clock list.
+		static const std::size_t INVALID_INDEX = ~std::size_t( 0 );
+
 		/// Time value of the last update, from TimeReferenceProvider (in seconds).
 		TimeValue m_lastUpdateTime;
 
@@ -130,6 +228,36 @@ namespace gcore
 		/// Maximum time elapsed allowed, or 0 or negative value if no limit set.
 		TimeValue m_max_deltaTime;
 
+		/** @name Fixed-step mode.
+		*/
+		//@{
+		TimeValue m_fixedStep;
+		unsigned int m_maxFixedSubstepCount;
+		unsigned int m_maxLateFixedSubstepCount;
+		TimeValue m_fixedStepTime; ///< Accumulated time not consumed by the executed steps yet.
+		unsigned int m_fixedSubstepCount;
+		TimeValue m_fixedStepAlpha;
+		TimeValue m_fixedStepDroppedTime;
+		//@}
+
+		/// Listeners to notify when a clock is destroyed.
+		std::vector< Listener* > m_listenerList;
+
+		/// Notify the listeners that a clock will be destroyed.
+		void notifyClockDestroyed( Clock& clock );
+
+		/// Order the clocks by depth, keeping the creation order in each depth.
+		void sortClocks();
+
+		/// Update the clocks in the range with the source delta times.
+		void advanceClocks( std::size_t begin, std::size_t end );
+
+		/// Accumulate the delta time and compute the fixed steps to execute.
+		void advanceFixedStep();
+
+		/// Destroy a Clock object and free it's memory.
+		void deleteClock( Clock* clock );
+
 	};
 
 }
@@ -0,0 +1,105 @@
+#ifndef GCORE_CONCURRENTQUEUE_H
+#define GCORE_CONCURRENTQUEUE_H
+#pragma once
+
+#include <boost/atomic.hpp>
+
+#include "GC_Common.h"
+
+namespace gcore
+{
+	/** Lock-free unbounded queue with multiple producers and a single consumer.
+		
+		Any thread can push values at any time, only one thread at a time can pop them.
+		Values are popped in the order they were pushed by each producer.
+		@par
+		Pushing never waits for the other threads, but a value being pushed
+		can make the following ones unavailable to pop until the push is finished : 
+		tryPop() then returns false even if values are in the queue. They will be 
+		available on the next tryPop() call.
+		@remark Each push allocates a node, released by the pop.
+	*/
+	template< class T >
+	class ConcurrentQueue
+	{
+	public:
+
+		ConcurrentQueue()
+			: m_head( new Node() )
+		{
+			m_tail = m_head.load( boost::memory_order_relaxed );
+		}
+
+		/** Destructor : destroy the values not popped.
+			@remark No thread can push values while destroying the queue.
+		*/
+		~ConcurrentQueue()
+		{
+			while( m_tail != nullptr )
+			{
+				Node* next = m_tail->next.load( boost::memory_order_relaxed );
+				delete m_tail;
+				m_tail = next;
+			}
+		}
+
+		/** Push a value at the end of the queue.
+			@remark Can be called by any thread.
+		*/
+		void push( const T& value )
+		{
+			Node* node = new Node( value );
+			Node* previous = m_head.exchange( node, boost::memory_order_acq_rel );
+			previous->next.store( node, boost::memory_order_release ); // make it visible to the consumer
+		}
+
+		/** Pop the first value of the queue if any.
+			@remark Consumer thread only.
+			@param value Receive the popped value.
+			@return true if a value was popped.
+		*/
+		bool tryPop( T& value )
+		{
+			Node* next = m_tail->next.load( boost::memory_order_acquire );
+			if( next == nullptr ) return false;
+
+			// the next node becomes the new empty tail node
+			value = next->value;
+			next->value = T();
+
+			delete m_tail;
+			m_tail = next;
+			return true;
+		}
+
+		/** True if there is no value to pop.
+			@remark Consumer thread only.
+		*/
+		bool empty() const { return m_tail->next.load( boost::memory_order_acquire ) == nullptr; }
+
+	private:
+
+		struct Node
+		{
+			Node() : next( nullptr ) {}
+			explicit Node( const T& v ) : next( nullptr ), value( v ) {}
+
+			boost::atomic< Node* > next;
+			T value;
+		};
+
+		/// Last node pushed, modified by the producers.
+		boost::atomic< Node* > m_head;
+
+		/// Node preceding the first value to pop, modified by the consumer only.
+		Node* m_tail;
+
+		// non copyable
+		ConcurrentQueue( const ConcurrentQueue& );
+		void operator=( const ConcurrentQueue& );
+
+	};
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,92 @@
+#include "GC_ConsoleCmd_TaskProfile.h"
+
+#include "GC_TaskManager.h"
+#include "GC_Console.h"
+#include "GC_UnicodeAscii.h"
+
+namespace gcore
+{
+	
+	ConsoleCmd_TaskProfile::ConsoleCmd_TaskProfile( const LocalizedString& name, TaskManager& taskManager, const TimeReferenceProvider& timeReference, TimeValue frameBudget )
+		: ConsoleCommand( name )
+		, m_taskManager( taskManager )
+		, m_timeReference( timeReference )
+		, m_frameBudget( frameBudget )
+	{
+		
+	}
+
+	ConsoleCmd_TaskProfile::~ConsoleCmd_TaskProfile()
+	{
+		
+	}
+
+	bool ConsoleCmd_TaskProfile::execute( Console & console , const std::vector< LocalizedString >& parameterList )
+	{
+		if(parameterList.size() != 1)
+		{
+			printErrorHelpMessage(console);
+			return false;
+		}
+
+		const LocalizedString& parameter( parameterList.at(0) );
+
+		if(parameter == L"start")
+		{
+			if( !m_taskManager.isTaskProfilingEnabled() )
+			{
+				m_taskManager.enableTaskProfiling( m_timeReference );
+				console.printText( L"Started tasks profiling." );
+			}
+			else
+			{
+				console.printText( L"/!\\Tasks profiling is already started!" );
+			}
+		}
+		else if (parameter == L"stop")
+		{
+			if( m_taskManager.isTaskProfilingEnabled() )
+			{
+				m_taskManager.disableTaskProfiling();
+				console.printText( L"Stopped tasks profiling." );
+			}
+			else
+			{
+				console.printText( L"/!\\Tasks profiling is not started!" );
+			}
+		}
+		else if (parameter == L"clear")
+		{
+			m_taskManager.clearTaskProfiles();
+			console.printText( L"Cleared tasks profiles." );
+		}
+		else if (parameter == L"report")
+		{
+			console.printText( AsciiToUTF16( m_taskManager.reportTaskProfiles( m_frameBudget ) ) );
+		}
+		else
+		{
+			printErrorHelpMessage(console);
+		}
+
+		return false;
+	}
+
+	void ConsoleCmd_TaskProfile::printErrorHelpMessage( Console& console )
+	{
+		console.printText( L"Invalid parameters ! Should be only ONE of the following : ");
+		console.printText( L" start, stop, clear, report" );
+	}
+
+	LocalizedString ConsoleCmd_TaskProfile::help() const
+	{
+		return	L"Help finding the Tasks that take too much time via a Console.\n" \
+				L"\n" \
+				L"Parameter | Call\n" \
+				L"----------------------------------------------------------\n" \
+				L"start     | start measuring the tasks execution times;\n" \
+				L"stop      | stop measuring the tasks execution times;\n" \
+				L"clear     | forget the measured execution times;\n" \
+				L"report    | print the execution times of the tasks, the most expensive first\n" ;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#ifndef GC_CONSOLECMD_TASKPROFILE_H
+#define GC_CONSOLECMD_TASKPROFILE_H
+#pragma once
+
+#include "GC_Common.h"
+#include "GC_Time.h"
+
+#include "GC_ConsoleCommand.h"
+
+namespace gcore
+{
+	class TaskManager;
+	class TimeReferenceProvider;
+	class Console;
+
+	/** Console Command that help finding the Tasks that take too much time via a Console.
+		It allow the user to link a command to a TaskManager in the console and 
+		use it via it's parameters matching the TaskManager profiling interface :
+		@par
+		 Parameter | Call
+		----------------------------------------------------------
+		 start     | taskManager.enableTaskProfiling( timeReference );
+		 stop      | taskManager.disableTaskProfiling();
+		 clear     | taskManager.clearTaskProfiles();
+		 report    | print taskManager.reportTaskProfiles( frameBudget )
+
+		@par 
+		@remark There should be only one parameter for each call.
+
+		@see ConsoleCommand	@see Console
+		@see TaskManager::enableTaskProfiling
+	*/
+	class GCORE_API ConsoleCmd_TaskProfile : public ConsoleCommand
+	{
+	public:
+
+		/** Constructor.
+			@param taskManager TaskManager to profile.
+			@param timeReference Time reference used to measure the Tasks execution times.
+			@param frameBudget Time a TaskManager::executeTasks call should not exceed, or 0 to not compare with a budget.
+		*/
+		ConsoleCmd_TaskProfile( const LocalizedString& name, TaskManager& taskManager, const TimeReferenceProvider& timeReference, TimeValue frameBudget = 0 );
+	
+		/** Destructor.
+		*/
+		~ConsoleCmd_TaskProfile();
+
+		bool execute( Console & console , const std::vector< LocalizedString >& parameterList);
+
+		LocalizedString help() const;
+
+		/// Time a TaskManager::executeTasks call should not exceed, or 0 if not set.
+		TimeValue frameBudget() const { return m_frameBudget; }
+
+		/// Set the time a TaskManager::executeTasks call should not exceed, or 0 to not compare with a budget.
+		void setFrameBudget( TimeValue frameBudget ) { m_frameBudget = frameBudget; }
+
+	protected:
+		
+	private:
+
+		/// Print error and help message in the console.
+		void printErrorHelpMessage( Console& console );
+
+		/// TaskManager to profile.
+		TaskManager& m_taskManager;
+
+		/// Time reference used to measure the Tasks execution times.
+		const TimeReferenceProvider& m_timeReference;
+
+		/// Time a TaskManager::executeTasks call should not exceed, or 0 if not set.
+		TimeValue m_frameBudget;
+	
+	};
+	
+
+}
+
+#endif
\ No newline at end of file
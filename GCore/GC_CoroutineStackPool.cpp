@@ -0,0 +1,101 @@
+#include <cstdlib>
+#include <new>
+#include <boost/thread/once.hpp>
+
+#include "GC_CoroutineStackPool.h"
+
+namespace gcore
+{
+	namespace
+	{
+		CoroutineStackPool& defaultPoolInstance()
+		{
+			static CoroutineStackPool pool;
+			return pool;
+		}
+
+		void createDefaultPool()
+		{
+			defaultPoolInstance();
+		}
+
+		/// Statically initialized : the default pool can be requested by any thread.
+		boost::once_flag defaultPoolFlag = BOOST_ONCE_INIT;
+	}
+
+	CoroutineStackPool::CoroutineStackPool( std::size_t stackSize, std::size_t reserveStackCount )
+		: m_stackSize( stackSize )
+		, m_usedStackCount( 0 )
+	{
+		GC_ASSERT( stackSize > 0, "Tried to create a CoroutineStackPool with empty stacks!" );
+
+		m_freeStacks.reserve( reserveStackCount );
+		for( std::size_t i = 0; i < reserveStackCount; ++i )
+		{
+			void* stack = std::malloc( m_stackSize );
+			if( stack == nullptr ) throw std::bad_alloc();
+			m_freeStacks.push_back( stack );
+		}
+	}
+
+	CoroutineStackPool::~CoroutineStackPool()
+	{
+		GC_ASSERT( m_usedStackCount == 0, "CoroutineStackPool destroyed while " << m_usedStackCount << " stacks are still used!" );
+
+		for( std::vector< void* >::iterator it = m_freeStacks.begin(); it != m_freeStacks.end(); ++it )
+		{
+			std::free( *it );
+		}
+	}
+
+	CoroutineStackPool& CoroutineStackPool::defaultPool()
+	{
+		// the function-local static is not initialized in a thread-safe way by all the compilers
+		boost::call_once( &createDefaultPool, defaultPoolFlag );
+		return defaultPoolInstance();
+	}
+
+	void* CoroutineStackPool::acquire()
+	{
+		boost::mutex::scoped_lock lock( m_mutex );
+
+		void* stack = nullptr;
+		if( !m_freeStacks.empty() )
+		{
+			stack = m_freeStacks.back();
+			m_freeStacks.pop_back();
+		}
+		else
+		{
+			stack = std::malloc( m_stackSize );
+			if( stack == nullptr ) throw std::bad_alloc();
+		}
+
+		++m_usedStackCount;
+		return stack;
+	}
+
+	void CoroutineStackPool::release( void* stack )
+	{
+		GC_ASSERT( stack != nullptr, "Tried to release a null stack in a CoroutineStackPool!" );
+
+		boost::mutex::scoped_lock lock( m_mutex );
+		GC_ASSERT( m_usedStackCount > 0, "Tried to release more stacks than acquired in a CoroutineStackPool!" );
+
+		m_freeStacks.push_back( stack );
+		--m_usedStackCount;
+	}
+
+	std::size_t CoroutineStackPool::usedStackCount() const
+	{
+		boost::mutex::scoped_lock lock( m_mutex );
+		return m_usedStackCount;
+	}
+
+	std::size_t CoroutineStackPool::freeStackCount() const
+	{
+		boost::mutex::scoped_lock lock( m_mutex );
+		return m_freeStacks.size();
+	}
+
+}
\ No newline at end of file
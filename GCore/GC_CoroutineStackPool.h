@@ -0,0 +1,81 @@
+#ifndef GC_COROUTINESTACKPOOL_H
+#define GC_COROUTINESTACKPOOL_H
+#pragma once
+
+#include <vector>
+#include <boost/thread/mutex.hpp>
+
+#include "GC_Common.h"
+
+namespace gcore
+{
+	/** Pool of fixed size stacks used to execute coroutines.
+		Released stacks are kept to be reused by the next coroutines instead of
+		being deallocated, so starting a coroutine doesn't allocate memory once the pool is warm.
+		@remark Thread-safe.
+		@see CoroutineTask
+	*/
+	class GCORE_API CoroutineStackPool
+	{
+	public:
+
+		/// Default size of the stacks, in bytes.
+		static const std::size_t DEFAULT_STACK_SIZE = 64 * 1024;
+
+		/** Constructor.
+			@param stackSize Size of each stack, in bytes.
+			@param reserveStackCount Number of stacks allocated immediately.
+		*/
+		explicit CoroutineStackPool( std::size_t stackSize = DEFAULT_STACK_SIZE, std::size_t reserveStackCount = 0 );
+
+		/** Destructor : deallocate the released stacks.
+			@remark All the stacks have to be released before destruction.
+		*/
+		~CoroutineStackPool();
+
+		/** Pool used by default by the CoroutineTasks.
+		*/
+		static CoroutineStackPool& defaultPool();
+
+		/// Size of each stack, in bytes.
+		std::size_t stackSize() const { return m_stackSize; }
+
+		/** Take a stack from the pool, allocating it if none is available.
+			@return Lowest address of the stack memory.
+		*/
+		void* acquire();
+
+		/** Give back a stack acquired from this pool.
+			@param stack Lowest address of the stack memory, as returned by acquire().
+		*/
+		void release( void* stack );
+
+		/// Number of stacks acquired and not released yet.
+		std::size_t usedStackCount() const;
+
+		/// Number of stacks available without allocation.
+		std::size_t freeStackCount() const;
+
+	private:
+
+		/// Size of each stack, in bytes.
+		const std::size_t m_stackSize;
+
+		/// Stacks available.
+		std::vector< void* > m_freeStacks;
+
+		/// Number of stacks acquired and not released yet.
+		std::size_t m_usedStackCount;
+
+		/// Protect the pool from concurrent use.
+		mutable boost::mutex m_mutex;
+
+		// non copyable
+		CoroutineStackPool( const CoroutineStackPool& );
+		void operator=( const CoroutineStackPool& );
+
+	};
+
+}
+
+#endif
\ No newline at end of file
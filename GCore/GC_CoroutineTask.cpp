@@ -0,0 +1,272 @@
+#define BOOST_COROUTINES_NO_DEPRECATION_WARNING
+#include <boost/coroutine/asymmetric_coroutine.hpp>
+#include <boost/coroutine/attributes.hpp>
+#include <boost/coroutine/stack_context.hpp>
+#include <boost/bind.hpp>
+
+#include "GC_CoroutineTask.h"
+#include "GC_TimerManager.h"
+#include "GC_EventManager.h"
+
+
+namespace gcore
+{
+	namespace
+	{
+		/// Stack allocator providing the coroutine stacks from a CoroutineStackPool.
+		class PooledStackAllocator
+		{
+		public:
+
+			explicit PooledStackAllocator( CoroutineStackPool& stackPool ) : m_stackPool( &stackPool ) {}
+
+			void allocate( boost::coroutines::stack_context& context, std::size_t size )
+			{
+				GC_ASSERT( size <= m_stackPool->stackSize(), "Coroutine stack size requested bigger than the stacks of the CoroutineStackPool!" );
+				(void)size; // only checked in debug builds
+
+				void* stack = m_stackPool->acquire();
+				context.size = m_stackPool->stackSize();
+				context.sp = static_cast< char* >( stack ) + context.size; // the stack grows down
+			}
+
+			void deallocate( boost::coroutines::stack_context& context )
+			{
+				m_stackPool->release( static_cast< char* >( context.sp ) - context.size );
+			}
+
+		private:
+
+			CoroutineStackPool* m_stackPool;
+		};
+	}
+
+	struct CoroutineTask::Coroutine
+	{
+		typedef boost::coroutines::asymmetric_coroutine< void > CoroutineType;
+
+		/// Continue the coroutine, called by the task.
+		CoroutineType::push_type resume;
+
+		/// Suspend the coroutine, called from the coroutine, null until started.
+		CoroutineType::pull_type* suspend;
+
+		/// True while the coroutine is executing.
+		bool isExecuting;
+
+		Coroutine( CoroutineTask& task, CoroutineStackPool& stackPool )
+			: resume( boost::bind( &Coroutine::run, this, &task, _1 ), boost::coroutines::attributes( stackPool.stackSize() ), PooledStackAllocator( stackPool ) )
+			, suspend( nullptr )
+			, isExecuting( false )
+		{}
+
+		void run( CoroutineTask* task, CoroutineType::pull_type& suspendFunction )
+		{
+			suspend = &suspendFunction;
+			task->runCoroutine();
+		}
+	};
+
+
+	CoroutineTask::CoroutineTask( TaskPriority priority /*= 0 */,const String& name /*= "" */, CoroutineStackPool& stackPool ) 
+		: Task( priority, name )
+		, m_coroutine( nullptr )
+		, m_stackPool( stackPool )
+		, m_waitType( WAIT_NONE )
+		, m_isWoken( false )
+		, m_timerManager( nullptr )
+		, m_eventManager( nullptr )
+		, m_phase( nullptr )
+		, m_phaseState( Phase::UNLOADED )
+	{
+
+	}
+
+	CoroutineTask::~CoroutineTask()
+	{
+		// too late to unwind the coroutine stack : the derived parts of this Task are already destroyed
+		GC_ASSERT( m_coroutine == nullptr, "CoroutineTask destroyed with a running coroutine : the derived class destructor must call stopCoroutine()! Task : " << name() );
+
+		cancelWait();
+		destroyCoroutine();
+	}
+
+	void CoroutineTask::stopCoroutine()
+	{
+		GC_ASSERT( m_coroutine == nullptr || !m_coroutine->isExecuting, "Tried to stop the coroutine from it's own execution code! Task : " << name() );
+
+		cancelWait();
+		destroyCoroutine();
+	}
+
+	void CoroutineTask::onExecute()
+	{
+		// woken up, or executed again by other means : the wait is over
+		if( m_waitType != WAIT_NONE ) cancelWait();
+
+		if( m_coroutine == nullptr )
+		{
+			m_coroutine = new Coroutine( *this, m_stackPool );
+		}
+
+		// continue the execution until the next wait or the end
+		try
+		{
+			m_coroutine->isExecuting = true;
+			m_coroutine->resume();
+			m_coroutine->isExecuting = false;
+		}
+		catch( ... )
+		{
+			// the coroutine is finished : start again next time
+			destroyCoroutine();
+			throw;
+		}
+
+		if( !m_coroutine->resume )
+		{
+			// execution code finished
+			destroyCoroutine();
+			if( isActive() || isPaused() ) this->terminate();
+		}
+		else if( isWaiting() && !m_isWoken && isActive() )
+		{
+			// don't execute until woken
+			this->pause();
+		}
+	}
+
+	void CoroutineTask::runCoroutine()
+	{
+		this->execute();
+	}
+
+	void CoroutineTask::suspend( WaitType waitType )
+	{
+		GC_ASSERT( m_coroutine != nullptr && m_coroutine->isExecuting, "Tried to wait outside of the execution code of the CoroutineTask! Task : " << name() );
+
+		m_waitType = waitType;
+		m_isWoken = false;
+
+		m_coroutine->isExecuting = false;
+		(*m_coroutine->suspend)();
+		m_coroutine->isExecuting = true;
+	}
+
+	void CoroutineTask::wake()
+	{
+		m_isWoken = true;
+		if( isPaused() ) this->resume();
+	}
+
+	void CoroutineTask::cancelWait()
+	{
+		switch( m_waitType )
+		{
+		case( WAIT_TIME ):
+			{
+				// the timer may already have been destroyed with all the timers of the manager
+				m_timerManager->destroyTimer( m_timerHandle );
+				m_timerHandle = TimerHandle();
+				m_timerManager = nullptr;
+				break;
+			}
+		case( WAIT_EVENT ):
+			{
+				if( !m_isWoken ) m_eventManager->removeListener( m_eventType, *this );
+				m_eventManager = nullptr;
+				break;
+			}
+		case( WAIT_PHASE_STATE ):
+			{
+				if( !m_isWoken ) m_phase->unregisterListener( this );
+				m_phase = nullptr;
+				break;
+			}
+		default:
+			{
+				break;
+			}
+		};
+
+		m_waitType = WAIT_NONE;
+		m_isWoken = false;
+	}
+
+	void CoroutineTask::destroyCoroutine()
+	{
+		// note : if the coroutine is not finished, it's stack is unwound here
+		delete m_coroutine;
+		m_coroutine = nullptr;
+	}
+
+	void CoroutineTask::waitNextCycle()
+	{
+		suspend( WAIT_NEXT_CYCLE );
+	}
+
+	void CoroutineTask::waitTime( TimerManager& timerManager, const Clock& clock, TimeValue timeSpan )
+	{
+		if( timeSpan <= 0 ) return; // nothing to wait for
+
+		m_timerManager = &timerManager;
+		Timer* timer = timerManager.createTimer( clock );
+		timer->setTriggerOnce();
+		timer->setWaitTime( timeSpan );
+		timer->registerListener( this );
+		m_timerHandle = timer->getHandle();
+
+		suspend( WAIT_TIME );
+	}
+
+	EventPtr CoroutineTask::waitEvent( EventManager& eventManager, Event::TypeId eventType )
+	{
+		m_eventManager = &eventManager;
+		m_eventType = eventType;
+		eventManager.addListener( *this, eventType );
+
+		suspend( WAIT_EVENT );
+
+		EventPtr e;
+		e.swap( m_event );
+		return e;
+	}
+
+	void CoroutineTask::waitPhaseState( Phase& phase, Phase::State state )
+	{
+		if( phase.state() == state ) return; // nothing to wait for
+
+		m_phase = &phase;
+		m_phaseState = state;
+		phase.registerListener( this );
+
+		suspend( WAIT_PHASE_STATE );
+	}
+
+	void CoroutineTask::onTimerTrigger( Timer& timer )
+	{
+		if( m_waitType == WAIT_TIME && timer.getHandle() == m_timerHandle && !m_isWoken )
+		{
+			wake();
+		}
+	}
+
+	void CoroutineTask::catchEvent( const EventPtr& e, EventManager& source )
+	{
+		if( m_waitType == WAIT_EVENT && &source == m_eventManager && !m_isWoken )
+		{
+			m_event = e;
+			source.removeListener( m_eventType, *this );
+			wake();
+		}
+	}
+
+	void CoroutineTask::onPhaseStateChanged( Phase& phase, const Phase::State /*previousState*/ )
+	{
+		if( m_waitType == WAIT_PHASE_STATE && &phase == m_phase && !m_isWoken && phase.state() == m_phaseState )
+		{
+			phase.unregisterListener( this );
+			wake();
+		}
+	}
+}
\ No newline at end of file
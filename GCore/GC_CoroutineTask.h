@@ -0,0 +1,189 @@
+#ifndef GC_COROUTINETASK_H
+#define GC_COROUTINETASK_H
+#pragma once
+
+#include "GC_Common.h"
+#include "GC_Time.h"
+#include "GC_Task.h"
+#include "GC_ProxyTask.h"
+#include "GC_Timer.h"
+#include "GC_Event.h"
+#include "GC_EventListener.h"
+#include "GC_Phase.h"
+#include "GC_CoroutineStackPool.h"
+
+namespace gcore
+{
+	class Clock;
+	class TimerManager;
+
+	/** Task that execute it's execution code as a coroutine that can wait across cycles.
+		The execute() method can call the wait methods (waitNextCycle, waitTime, waitEvent, waitPhaseState)
+		to suspend it's execution : the execution continues after the wait call once the waited
+		thing happened, in a later cycle. This allow to write multi-cycle logic as simple sequential code.
+		@par
+		While waiting for something else than the next cycle, the Task pauses itself so it is not executed
+		at all, and resumes itself once woken : Task::onPaused and Task::onResumed are called then.
+		If the Task is resumed (or activated again) by other means while waiting, the wait ends early.
+		@par
+		Once execute() returns, the Task terminates itself. It will start execute() from the beginning if activated again.
+		@par
+		Each running coroutine uses a stack from a CoroutineStackPool, so a lot of waiting Tasks only cost memory.
+		@remark Stopping the coroutine while it is waiting unwinds the coroutine stack by throwing
+			an exception in it : the execution code must not catch all exceptions (catch(...)) without throwing them again.
+		@remark The coroutine stack references the members of the derived classes : the destructor of the
+			class implementing execute() must call stopCoroutine(), before it's members are destroyed.
+		@remark The wait methods can only be called from the execution code of this Task.
+	*/
+	class GCORE_API CoroutineTask 
+		: virtual public Task
+		, private TimerListener
+		, private EventListener
+		, private Phase::Listener
+	{
+	public:
+
+		/** Constructor.
+			@see Task::Task
+			@param stackPool Pool providing the stacks of the coroutines, must outlive this Task.
+		*/
+		CoroutineTask( TaskPriority priority = 0 ,const String& name = "", CoroutineStackPool& stackPool = CoroutineStackPool::defaultPool() );
+
+		/** Destructor.
+			@remark The coroutine must have been stopped by the destructor of the derived class.
+			@see stopCoroutine
+		*/
+		virtual ~CoroutineTask();
+
+		/// True if the coroutine is started and not finished yet.
+		bool isRunning() const { return m_coroutine != nullptr; }
+
+		/// True if the coroutine is waiting for something else than the next cycle.
+		bool isWaiting() const { return m_waitType != WAIT_NONE && m_waitType != WAIT_NEXT_CYCLE; }
+
+		/** Suspend the execution until the next cycle.
+		*/
+		void waitNextCycle();
+
+		/** Suspend the execution until a time span passed on a Clock.
+			@param timerManager TimerManager used to create the Timer waiting for the time span.
+			@param clock Clock giving the time.
+			@param timeSpan Time to wait, in the clock time.
+		*/
+		void waitTime( TimerManager& timerManager, const Clock& clock, TimeValue timeSpan );
+
+		/** Suspend the execution until an Event of the provided type is processed by an EventManager.
+			@param eventManager EventManager that will process the Event.
+			@param eventType Type of the Event to wait for.
+			@return The Event that woke this Task, or null if the wait ended early.
+		*/
+		EventPtr waitEvent( EventManager& eventManager, Event::TypeId eventType );
+
+		/** Suspend the execution until a Phase reach a state.
+			@remark Don't wait if the Phase is already in this state.
+			@param phase Phase to watch.
+			@param state State to wait for.
+		*/
+		void waitPhaseState( Phase& phase, Phase::State state );
+
+	protected:
+
+		/** Execution behavior : here we continue the coroutine executing 
+			the execution code.
+		*/
+		virtual void onExecute();
+
+		/** Stop the coroutine, unwinding it's stack if it is waiting, and forget what it was waiting for.
+			The next execution starts execute() from the beginning.
+			@remark Must be called by the destructor of the derived class implementing execute().
+			@remark Can't be called from the execution code of this Task.
+		*/
+		void stopCoroutine();
+
+	private:
+
+		/// Types of wait.
+		enum WaitType
+		{
+			WAIT_NONE = 0,
+			WAIT_NEXT_CYCLE,
+			WAIT_TIME,
+			WAIT_EVENT,
+			WAIT_PHASE_STATE,
+		};
+
+		/// Coroutine executing the execution code (implementation).
+		struct Coroutine;
+
+		/// Current coroutine, or null if not running.
+		Coroutine* m_coroutine;
+
+		/// Pool providing the stacks of the coroutines.
+		CoroutineStackPool& m_stackPool;
+
+		/// What the coroutine is waiting for.
+		WaitType m_waitType;
+
+		/// True if the waited thing happened.
+		bool m_isWoken;
+
+		/// Timer used while waiting for a time span.
+		TimerHandle m_timerHandle;
+		TimerManager* m_timerManager;
+
+		/// EventManager and Event type waited, and the Event received.
+		EventManager* m_eventManager;
+		Event::TypeId m_eventType;
+		EventPtr m_event;
+
+		/// Phase and state waited.
+		Phase* m_phase;
+		Phase::State m_phaseState;
+
+		/// Entry point of the coroutine.
+		void runCoroutine();
+
+		/// Suspend the coroutine until woken.
+		void suspend( WaitType waitType );
+
+		/// Wake up the task after the end of a wait.
+		void wake();
+
+		/// Stop listening for the waited thing and forget it.
+		void cancelWait();
+
+		/// Destroy the coroutine, unwinding it's stack if not finished.
+		void destroyCoroutine();
+
+		void onTimerTrigger( Timer& timer );
+		void catchEvent( const EventPtr& e, EventManager& source );
+		void onPhaseStateChanged( Phase& phase, const Phase::State previousState );
+
+	};
+
+#pragma warning( push )
+#pragma warning( disable : 4250 ) // we want to use ProxyTask definitions, yes..
+
+	class CoroutineProxyTask 
+		: public ProxyTask
+		, public CoroutineTask
+	{ 
+	public:
+		CoroutineProxyTask( const TaskFunction& executeFunction
+			, const TaskFunction& onActivateFunction = &ProxyTask::emptyFunction, const TaskFunction& onTerminateFunction = &ProxyTask::emptyFunction
+			, const TaskFunction& onPausedFunction = &ProxyTask::emptyFunction, const TaskFunction& onResumedFunction = &ProxyTask::emptyFunction
+			, TaskPriority priority = 0, const String& name = "", CoroutineStackPool& stackPool = CoroutineStackPool::defaultPool() ) 
+			: CoroutineTask( priority, name, stackPool )
+			, ProxyTask( executeFunction, onActivateFunction, onTerminateFunction, onPausedFunction, onResumedFunction, priority, name )
+		{}
+
+		~CoroutineProxyTask()
+		{
+			stopCoroutine();
+		}
+	};
+#pragma warning( pop )
+
+}
+
+#endif
\ No newline at end of file
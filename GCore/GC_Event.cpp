@@ -7,5 +7,15 @@ namespace gcore
 		return EventPtr( new Event( type ) );
 	}
 
+	EventPtr makeEvent( const char* typeName )
+	{
+		return makeEvent( Event::TypeId( typeName ) );
+	}
+
+	EventPtr makeEvent( const std::string& typeName )
+	{
+		return makeEvent( Event::TypeId( typeName ) );
+	}
+
 
 }
\ No newline at end of file
@@ -3,9 +3,9 @@
 #pragma once
 
 #include <memory>
-#include <string>
 
 #include "GC_Common.h"
+#include "GC_EventTypeId.h"
 
 namespace gcore
 {
@@ -29,7 +29,7 @@ namespace gcore
 	public:
 
 		///Event type id.
-		typedef std::string TypeId;
+		typedef EventTypeId TypeId;
 
 		/** Constructor.
 			@param type Type of this event.
@@ -58,6 +58,10 @@ namespace gcore
 	/** Utility function to create a simple event with it's pointer "on the fly" with the default basic allocator.*/
 	EventPtr GCORE_API makeEvent( Event::TypeId type );
 
+	/** Convenience version of makeEvent taking the name of the type : the name is hashed on each call. */
+	EventPtr GCORE_API makeEvent( const char* typeName );
+	EventPtr GCORE_API makeEvent( const std::string& typeName );
+
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,268 @@
+#ifndef GCORE_EVENTCHANNEL_H
+#define GCORE_EVENTCHANNEL_H
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <functional>
+
+#include "GC_Common.h"
+
+namespace gcore
+{
+	/** Typed event channel : events of one type, stored by value, dispatched to typed subscribers.
+		
+		An EventChannel is a lightweight alternative to EventManager for frequent events of a known type :
+		there is no Event object to allocate, no type id to look up and no cast to get the data.
+		The events sent are stored by value in a contiguous buffer, then process() calls the subscribers 
+		with them.
+		@par
+		Subscribers can catch the events one by one or all at once (batch subscribers), the latter 
+		letting the subscriber loop on the events without any indirect call.
+		Where the handler is known at compile time, consume() calls it directly for each event, 
+		allowing the compiler to inline it.
+		@par
+		Like the buffered sends of EventManager, events sent while processing are kept for the next process().
+		@remark Not thread-safe.
+		@see EventManager
+	*/
+	template< typename EventType >
+	class EventChannel
+	{
+	public:
+
+		/// Function-like object catching events one by one.
+		typedef std::tr1::function< void ( const EventType& ) > Subscriber;
+
+		/// Function-like object catching all the events of a process() at once.
+		typedef std::tr1::function< void ( const EventType* events, std::size_t count ) > BatchSubscriber;
+
+		/// Identify a subscription, to unsubscribe. Never 0.
+		typedef std::size_t SubscriptionId;
+
+		/** Constructor.
+			@param reserveEventCount Number of events to reserve memory for.
+		*/
+		explicit EventChannel( std::size_t reserveEventCount = 0 )
+			: m_nextSubscriptionId( 1 )
+			, m_isProcessing( false )
+			, m_hasRemovedSubscriptions( false )
+		{
+			m_events.reserve( reserveEventCount );
+			m_processEvents.reserve( reserveEventCount );
+		}
+
+		/** Send an event, to process on the next process() call.
+			@param e Event to copy in the channel.
+		*/
+		void send( const EventType& e ) { m_events.push_back( e ); }
+
+		/// Number of events sent and not processed yet.
+		std::size_t pendingEventCount() const { return m_events.size(); }
+
+		/** Subscribe to catch the events one by one.
+			@return Id of the subscription.
+		*/
+		SubscriptionId subscribe( const Subscriber& subscriber )
+		{
+			GC_ASSERT( subscriber, "Tried to subscribe an empty subscriber to an event channel!" );
+			return addSubscription( subscriber, BatchSubscriber() );
+		}
+
+		/** Subscribe to catch all the events of a process() at once.
+			@return Id of the subscription.
+		*/
+		SubscriptionId subscribeBatch( const BatchSubscriber& subscriber )
+		{
+			GC_ASSERT( subscriber, "Tried to subscribe an empty batch subscriber to an event channel!" );
+			return addSubscription( Subscriber(), subscriber );
+		}
+
+		/** Remove a subscription.
+			@remark Can be called while processing : the subscriber will not catch the next events.
+		*/
+		void unsubscribe( SubscriptionId subscriptionId )
+		{
+			// subscribed while processing : not called yet
+			typename SubscriptionList::iterator addedIt = std::find_if( m_addedSubscriptions.begin(), m_addedSubscriptions.end(), HasId( subscriptionId ) );
+			if( addedIt != m_addedSubscriptions.end() )
+			{
+				m_addedSubscriptions.erase( addedIt );
+				return;
+			}
+
+			typename SubscriptionList::iterator it = std::find_if( m_subscriptions.begin(), m_subscriptions.end(), HasId( subscriptionId ) );
+			GC_ASSERT( it != m_subscriptions.end(), "Tried to unsubscribe an unknown subscription from an event channel!" );
+			if( it == m_subscriptions.end() ) return;
+
+			if( m_isProcessing )
+			{
+				it->id = 0; // removed once the processing is finished
+				m_hasRemovedSubscriptions = true;
+			}
+			else
+			{
+				m_subscriptions.erase( it );
+			}
+		}
+
+		/// Remove all the subscriptions.
+		void unsubscribeAll()
+		{
+			GC_ASSERT( !m_isProcessing, "Tried to remove all the subscriptions of an event channel while processing!" );
+			m_subscriptions.clear();
+		}
+
+		/// Number of subscriptions.
+		std::size_t subscriptionCount() const { return m_subscriptions.size() + m_addedSubscriptions.size(); }
+
+		/** Dispatch the events sent since the last process() to the subscribers, in the sending order.
+			Each subscriber catches all the events before the next subscriber, in the subscription order.
+		*/
+		void process()
+		{
+			GC_ASSERT( !m_isProcessing, "Tried to process an event channel while processing it!" );
+
+			if( m_events.empty() ) return; // be lazy!
+
+			m_processEvents.swap( m_events ); // ready for the events sent while processing
+			const EventType* events = &m_processEvents[0];
+			const std::size_t eventCount = m_processEvents.size();
+
+			m_isProcessing = true;
+			try
+			{
+				// new subscriptions are added to the list once the processing is finished : they will catch the next events
+				const std::size_t subscriptionCount = m_subscriptions.size();
+				for( std::size_t i = 0; i < subscriptionCount; ++i )
+				{
+					if( m_subscriptions[i].id == 0 ) continue; // removed
+
+					if( m_subscriptions[i].batchSubscriber )
+					{
+						m_subscriptions[i].batchSubscriber( events, eventCount );
+						continue;
+					}
+
+					for( std::size_t eventIdx = 0; eventIdx < eventCount && m_subscriptions[i].id != 0; ++eventIdx )
+					{
+						m_subscriptions[i].subscriber( events[ eventIdx ] );
+					}
+				}
+			}
+			catch( ... )
+			{
+				endProcess();
+				throw;
+			}
+			endProcess();
+		}
+
+		/** Dispatch the events sent since the last process() to a handler only, in the sending order.
+			The handler is called directly, so it can be inlined : use it for the hottest paths.
+			@param handler Function-like object called with each event as a const reference.
+		*/
+		template< class Handler >
+		void consume( Handler& handler )
+		{
+			GC_ASSERT( !m_isProcessing, "Tried to consume the events of an event channel while processing it!" );
+
+			if( m_events.empty() ) return; // be lazy!
+
+			m_processEvents.swap( m_events );
+
+			m_isProcessing = true;
+			try
+			{
+				const std::size_t eventCount = m_processEvents.size();
+				for( std::size_t i = 0; i < eventCount; ++i )
+				{
+					handler( m_processEvents[i] );
+				}
+			}
+			catch( ... )
+			{
+				endProcess();
+				throw;
+			}
+			endProcess();
+		}
+
+		/** Cancel the events sent and not processed yet. */
+		void clear() { m_events.clear(); }
+
+	private:
+
+		struct Subscription
+		{
+			SubscriptionId id; // 0 when removed while processing
+			Subscriber subscriber;
+			BatchSubscriber batchSubscriber;
+		};
+
+		typedef std::vector< Subscription > SubscriptionList;
+
+		struct HasId
+		{
+			explicit HasId( SubscriptionId id ) : m_id( id ) {}
+			bool operator()( const Subscription& subscription ) const { return subscription.id == m_id; }
+			SubscriptionId m_id;
+		};
+
+		/// Events sent since the last process.
+		std::vector< EventType > m_events;
+
+		/// Events being processed, kept to reuse the memory.
+		std::vector< EventType > m_processEvents;
+
+		/// Subscriptions, in subscription order.
+		SubscriptionList m_subscriptions;
+
+		/// Subscriptions added while processing, added to the subscriptions list once the processing is finished.
+		SubscriptionList m_addedSubscriptions;
+
+		SubscriptionId m_nextSubscriptionId;
+		bool m_isProcessing;
+		bool m_hasRemovedSubscriptions;
+
+		SubscriptionId addSubscription( const Subscriber& subscriber, const BatchSubscriber& batchSubscriber )
+		{
+			Subscription subscription;
+			subscription.id = m_nextSubscriptionId++;
+			subscription.subscriber = subscriber;
+			subscription.batchSubscriber = batchSubscriber;
+
+			// don't reallocate the subscriptions list while a subscriber is executing
+			if( m_isProcessing ) m_addedSubscriptions.push_back( subscription );
+			else m_subscriptions.push_back( subscription );
+
+			return subscription.id;
+		}
+
+		void endProcess()
+		{
+			m_processEvents.clear(); // keep the memory
+			m_isProcessing = false;
+
+			if( m_hasRemovedSubscriptions )
+			{
+				m_subscriptions.erase( std::remove_if( m_subscriptions.begin(), m_subscriptions.end(), HasId( 0 ) ), m_subscriptions.end() );
+				m_hasRemovedSubscriptions = false;
+			}
+
+			if( !m_addedSubscriptions.empty() )
+			{
+				m_subscriptions.insert( m_subscriptions.end(), m_addedSubscriptions.begin(), m_addedSubscriptions.end() );
+				m_addedSubscriptions.clear();
+			}
+		}
+
+		// non copyable
+		EventChannel( const EventChannel& );
+		void operator=( const EventChannel& );
+
+	};
+
+}
+
+#endif
\ No newline at end of file
@@ -41,6 +41,13 @@ namespace gcore
 		*/
 		virtual void catchEvent(const EventPtr& e, EventManager& source) = 0;
 
+		/** True if this listener can catch events from any thread, concurrently with the other listeners 
+			and with itself (for different event types). False by default.
+			@remark Read when the listener is added to an EventManager.
+			@see EventManager::enableParallelDispatch
+		*/
+		virtual bool canCatchConcurrently() const { return false; }
+
 		virtual ~EventListener() {}
 		
 	protected:
@@ -49,6 +56,32 @@ namespace gcore
 
 	};
 
+	/** EventListener that can catch several events of the same type in one call.
+		
+		When batch dispatch is enabled in an EventManager, the buffered events are grouped by type
+		and a BatchEventListener receives all the events of a type it listens to in one call to catchEvents(),
+		in the order they were sent.
+		Otherwise it receives them one by one, as one event batches.
+		@see EventManager::enableBatchDispatch
+	*/
+	class GCORE_API BatchEventListener : public EventListener
+	{
+	public:
+
+		/** User defined Events reception.
+			@param events First of the Events that have been sent, all of the same type.
+			@param count Number of Events.
+			@param source EventManager that processed the events.
+		*/
+		virtual void catchEvents( const EventPtr* events, std::size_t count, EventManager& source ) = 0;
+
+		void catchEvent( const EventPtr& e, EventManager& source )
+		{
+			catchEvents( &e, 1, source );
+		}
+
+	};
+
 	/// Function-like object that can catch events.
 	typedef std::tr1::function< void (const EventPtr& , EventManager& ) > EventListenerFunction;
 
@@ -1,74 +1,249 @@
 #include "GC_EventManager.h"
 
 #include <algorithm>
+#include <cmath>
+
+#include "GC_Clock.h"
+#include "GC_ClockDataMap.h"
+#include "GC_TimingWheel.h"
+#include "GC_WorkerPool.h"
 
 namespace gcore
 {
+	/** Delayed events of each clock, in timing wheels ticking at the delay resolution.
+		The wheel time only follows the clock time going forward.
+	*/
+	struct EventManager::DelayedEvents
+	{
+		typedef TimingWheel< EventPtr > EventWheel;
+
+		/// Delayed events of a clock.
+		struct ClockSchedule
+		{
+			ClockSchedule( const Clock& c ) : clock( c ), wheelTime( 0 ), lastClockTime( c.time() ) {}
+
+			const Clock& clock;
+			EventWheel wheel;
+
+			/// Clock time elapsed going forward since the schedule creation.
+			TimeValue wheelTime;
+
+			/// Clock time on the last synchronization.
+			TimeValue lastClockTime;
+
+			/// Add the clock time elapsed forward since the last synchronization.
+			void synchronize()
+			{
+				const TimeValue clockTime = clock.time();
+				if( clockTime > lastClockTime ) wheelTime += clockTime - lastClockTime;
+				lastClockTime = clockTime;
+			}
+		};
+
+		typedef ClockDataMap< ClockSchedule > ScheduleMap;
+
+		/// Schedule of each clock with delayed events, destroyed with the clock.
+		ScheduleMap schedules;
+
+		/// Events expired in the last advance.
+		std::vector< EventPtr > expiredEvents;
+
+		std::size_t count() const
+		{
+			std::size_t eventCount = 0;
+			for( ScheduleMap::const_iterator it = schedules.begin(); it != schedules.end(); ++it )
+			{
+				eventCount += it->second->wheel.size();
+			}
+			return eventCount;
+		}
+	};
+
+	namespace
+	{
+		bool isEventTypeLower( const EventPtr& left, const EventPtr& right )
+		{
+			return left->type() < right->type();
+		}
+
+		/// End of the group of events of the same type starting at begin, in a queue sorted by type.
+		std::size_t typeGroupEnd( const std::vector< EventPtr >& events, std::size_t begin )
+		{
+			const Event::TypeId type = events[ begin ]->type();
+			std::size_t end = begin + 1;
+			while( end < events.size() && events[ end ]->type() == type )
+			{
+				++end;
+			}
+			return end;
+		}
+	}
 
 	EventManager::EventManager()
+		: m_dispatchDepth( 0 )
+		, m_concurrentQueue( nullptr )
+		, m_workerPool( nullptr )
+		, m_concurrentListenerCount( 0 )
+		, m_isDispatchingInParallel( false )
+		, m_bufferGeneration( 0 )
+		, m_delayedEvents( nullptr )
+		, m_delayedEventResolution( 0.001 )
+		, m_isBatchDispatchEnabled( false )
+	{
+	}
+
+	EventManager::Coalescing::Coalescing()
+		: policy( ECP_NONE )
+		, generation( 0 )
+		, bufferedIndex( 0 )
+		, droppedCount( 0 )
+		, mergedCount( 0 )
 	{
-		// arbitrary optimizations
-		m_processListeners.reserve( 32 ); 
-		
 	}
 
 
 	EventManager::~EventManager()
 	{
 		clear();
+		delete m_concurrentQueue;
+		delete m_delayedEvents;
 	}
 
 	void EventManager::addListener( EventListener& eventListener, Event::TypeId typeToCatch )
 	{
 		// get the listeners for this event type or create it
-		EventListenerList& listeners = m_listenerRegister[ typeToCatch ]; 
+		EventListenerList& listeners = typeToCatch.isNull() ? m_catchAllListeners.listeners : m_listenerRegister[ typeToCatch ].listeners; 
 
 		// check
 		GC_ASSERT( std::find( listeners.begin(), listeners.end(), &eventListener ) == listeners.end(), "Tried to add the same listener twice for event " << typeToCatch );
 
 		// register the listener
-		listeners.push_back( &eventListener );
+		ListenerEntry entry;
+		entry.listener = &eventListener;
+		entry.batchListener = dynamic_cast< BatchEventListener* >( &eventListener );
+		entry.isConcurrent = eventListener.canCatchConcurrently();
+		listeners.push_back( entry );
+
+		if( entry.isConcurrent ) ++m_concurrentListenerCount;
 
 	}
 
 	void EventManager::removeListener( EventListener& eventListener )
 	{
-		if( m_listenerRegister.empty() )
+		if( m_listenerRegister.empty() && m_catchAllListeners.listeners.empty() )
 		{
-			GC_ASSERT( !m_listenerRegister.empty(), "Tried to remove a listener from an empty event manager!" );
+			GC_ASSERT( false, "Tried to remove a listener from an empty event manager!" );
 			return; 
 		}
 
+		removeFromTable( m_catchAllListeners, eventListener );
+
 		EventListenerRegister::iterator register_it = m_listenerRegister.begin();
 
 		for( ; register_it != m_listenerRegister.end(); ++register_it )
 		{
-			EventListenerList& listeners = register_it->second;
+			ListenerTable& table = register_it->second;
 
-			if( listeners.empty() ) continue; // be lazy;
+			if( table.listeners.empty() ) continue; // be lazy;
 
-			listeners.remove( &eventListener );
+			removeFromTable( table, eventListener );
 		}
 
 	}
 
 	void EventManager::removeListener(  Event::TypeId typeToCatch, EventListener& eventListener )
 	{
+		if( typeToCatch.isNull() )
+		{
+			removeFromTable( m_catchAllListeners, eventListener );
+			return;
+		}
+
 		EventListenerRegister::iterator it = m_listenerRegister.find( typeToCatch );
 
 		GC_ASSERT( it != m_listenerRegister.end(), "Tried to remove listener from unregistered event type : " << typeToCatch );
 
 		if( it != m_listenerRegister.end() )
 		{
-			EventListenerList& listeners = it->second;
-			listeners.remove( &eventListener );
+			removeFromTable( it->second, eventListener );
 		}
 
 	}
 
 	void EventManager::removeAllListeners()
 	{
+		if( m_dispatchDepth > 0 )
+		{
+			// the tables are being used : just mark all the listeners removed
+			for( EventListenerRegister::iterator it = m_listenerRegister.begin(); it != m_listenerRegister.end(); ++it )
+			{
+				markAllRemoved( it->second );
+			}
+			markAllRemoved( m_catchAllListeners );
+			return;
+		}
+
 		m_listenerRegister.clear();
+		m_catchAllListeners.listeners.clear();
+		m_concurrentListenerCount = 0;
+	}
+
+	void EventManager::removeFromTable( ListenerTable& table, EventListener& eventListener )
+	{
+		EventListenerList& listeners = table.listeners;
+		EventListenerList::iterator it = std::find( listeners.begin(), listeners.end(), &eventListener );
+		if( it == listeners.end() ) return;
+
+		GC_ASSERT( !( it->isConcurrent && m_isDispatchingInParallel ), "Tried to remove a concurrent listener while it is dispatched in parallel!" );
+		if( it->isConcurrent ) --m_concurrentListenerCount;
+
+		if( m_dispatchDepth == 0 )
+		{
+			listeners.erase( it ); // keep the registration order
+			return;
+		}
+
+		// being dispatched : the table will be compacted once the dispatch is finished
+		it->listener = nullptr;
+		it->batchListener = nullptr;
+		it->isConcurrent = false;
+		if( !table.hasRemovedListeners )
+		{
+			table.hasRemovedListeners = true;
+			m_tablesToCompact.push_back( &table );
+		}
+	}
+
+	void EventManager::markAllRemoved( ListenerTable& table )
+	{
+		if( table.listeners.empty() ) return;
+
+		for( EventListenerList::iterator it = table.listeners.begin(); it != table.listeners.end(); ++it )
+		{
+			GC_ASSERT( !( it->isConcurrent && m_isDispatchingInParallel ), "Tried to remove a concurrent listener while it is dispatched in parallel!" );
+			if( it->isConcurrent ) --m_concurrentListenerCount;
+			it->listener = nullptr;
+			it->batchListener = nullptr;
+			it->isConcurrent = false;
+		}
+		if( !table.hasRemovedListeners )
+		{
+			table.hasRemovedListeners = true;
+			m_tablesToCompact.push_back( &table );
+		}
+	}
+
+	void EventManager::compactTables()
+	{
+		GC_ASSERT( m_dispatchDepth == 0, "Tried to compact the listener tables while dispatching!" );
+
+		for( std::vector< ListenerTable* >::iterator it = m_tablesToCompact.begin(); it != m_tablesToCompact.end(); ++it )
+		{
+			ListenerTable& table = **it;
+			table.listeners.erase( std::remove( table.listeners.begin(), table.listeners.end(), static_cast< EventListener* >( nullptr ) ), table.listeners.end() );
+			table.hasRemovedListeners = false;
+		}
+		m_tablesToCompact.clear();
 	}
 
 	void EventManager::clear()
@@ -82,42 +257,436 @@ namespace gcore
 
 		if( immediate )
 		{
-			processEvent( e );
+			processEvent( e, false );
+		}
+		else if( m_concurrentQueue != nullptr )
+		{
+			m_concurrentQueue->push( e );
 		}
 		else
 		{
-			m_eventQueue.push_back( e );
+			bufferEvent( e );
+		}
+
+	}
+
+	void EventManager::sendDelayed( const EventPtr& e, const Clock& clock, TimeValue delay )
+	{
+		GC_ASSERT_NOT_NULL( e.get() );
+
+		if( m_delayedEvents == nullptr )
+		{
+			m_delayedEvents = new DelayedEvents();
+		}
+
+		DelayedEvents::ClockSchedule& clockSchedule = m_delayedEvents->schedules.findOrCreate( clock );
+		clockSchedule.synchronize();
+
+		// rounded up : never sent early
+		const TimeValue sendTime = clockSchedule.wheelTime + std::max< TimeValue >( delay, 0 );
+		const DelayedEvents::EventWheel::Tick tick = static_cast< DelayedEvents::EventWheel::Tick >( std::ceil( sendTime / m_delayedEventResolution ) );
+		clockSchedule.wheel.schedule( tick, e );
+	}
+
+	void EventManager::sendAt( const EventPtr& e, const Clock& clock, TimeValue time )
+	{
+		sendDelayed( e, clock, time - clock.time() );
+	}
+
+	void EventManager::cancelDelayedEvents( const Clock& clock )
+	{
+		if( m_delayedEvents == nullptr ) return;
+
+		m_delayedEvents->schedules.destroy( clock );
+	}
+
+	void EventManager::cancelAllDelayedEvents()
+	{
+		delete m_delayedEvents;
+		m_delayedEvents = nullptr;
+	}
+
+	std::size_t EventManager::delayedEventCount() const
+	{
+		return m_delayedEvents != nullptr ? m_delayedEvents->count() : 0;
+	}
+
+	void EventManager::delayedEventResolution( TimeValue resolution )
+	{
+		GC_ASSERT( resolution > 0, "Delayed event resolution have to be positive!" );
+		GC_ASSERT( delayedEventCount() == 0, "Tried to change the delayed event resolution while delayed events are waiting!" );
+
+		m_delayedEventResolution = resolution;
+	}
+
+	void EventManager::gatherDelayedEvents()
+	{
+		if( m_delayedEvents == nullptr ) return;
+
+		std::vector< EventPtr >& expiredEvents = m_delayedEvents->expiredEvents;
+
+		for( DelayedEvents::ScheduleMap::iterator it = m_delayedEvents->schedules.begin(); it != m_delayedEvents->schedules.end(); ++it )
+		{
+			DelayedEvents::ClockSchedule& clockSchedule = *it->second;
+			clockSchedule.synchronize();
+
+			if( clockSchedule.wheel.empty() ) continue; // be lazy!
+
+			const DelayedEvents::EventWheel::Tick tick = static_cast< DelayedEvents::EventWheel::Tick >( std::floor( clockSchedule.wheelTime / m_delayedEventResolution ) );
+			clockSchedule.wheel.advance( tick, expiredEvents );
 		}
 
+		for( std::vector< EventPtr >::iterator it = expiredEvents.begin(); it != expiredEvents.end(); ++it )
+		{
+			bufferEvent( *it );
+		}
+		expiredEvents.clear();
 	}
 
 	void EventManager::process()
 	{
-		if( m_eventQueue.empty() ) return; // be lazy!!!
+		gatherConcurrentEvents();
+		gatherDelayedEvents();
+
+		if( !m_eventQueue.empty() )
+		{
+			// first we have to swap the current event queue with the process one (empty)
+			m_processEventQueue.clear();
+			m_processEventQueue.swap( m_eventQueue ); // ready for the next event sent
+			++m_bufferGeneration; // coalescing starts again with the next event sent
+
+			if( m_isBatchDispatchEnabled )
+			{
+				// group the events by type, keeping the order of each type
+				std::stable_sort( m_processEventQueue.begin(), m_processEventQueue.end(), &isEventTypeLower );
+			}
+
+			// concurrent listeners first : they work while the others are dispatched
+			const bool isDispatchingInParallel = startParallelDispatch();
+			m_isDispatchingInParallel = isDispatchingInParallel;
+
+			try
+			{
+				if( m_isBatchDispatchEnabled )
+				{
+					processBatches( isDispatchingInParallel );
+				}
+				else
+				{
+					// now we have to process each event in the processing queue
+					for( EventQueue::iterator it = m_processEventQueue.begin(); it != m_processEventQueue.end(); ++it )
+					{
+						const EventPtr e = *it;
+						GC_ASSERT_NOT_NULL( e.get() );
+						processEvent( e, isDispatchingInParallel );
+					}
+				}
+			}
+			catch( ... )
+			{
+				if( isDispatchingInParallel )
+				{
+					// the jobs use the processing queue : let them finish
+					try { m_workerPool->wait(); }
+					catch( ... ) { ; } // the first failure is reported
+					m_isDispatchingInParallel = false;
+					m_groupedEventQueue.clear();
+				}
+				throw;
+			}
+
+			if( isDispatchingInParallel )
+			{
+				try { m_workerPool->wait(); }
+				catch( ... )
+				{
+					m_isDispatchingInParallel = false;
+					m_groupedEventQueue.clear();
+					throw;
+				}
+				m_isDispatchingInParallel = false;
+				m_groupedEventQueue.clear();
+			}
+
+			m_processEventQueue.clear(); // release the processed events
+		}
+
+		// the processed events not kept by listeners can now be reused
+		m_eventPool.recycle();
+
+	}
+
+	void EventManager::enableConcurrentSend()
+	{
+		if( m_concurrentQueue != nullptr ) return;
+		m_concurrentQueue = new ConcurrentQueue< EventPtr >();
+	}
+
+	void EventManager::disableConcurrentSend()
+	{
+		if( m_concurrentQueue == nullptr ) return;
+
+		gatherConcurrentEvents(); // keep them for the next process()
+		GC_ASSERT( m_concurrentQueue->empty(), "Concurrent send disabled while events are still being sent!" );
+
+		delete m_concurrentQueue;
+		m_concurrentQueue = nullptr;
+	}
+
+	void EventManager::gatherConcurrentEvents()
+	{
+		if( m_concurrentQueue == nullptr ) return;
+
+		// append them to the events buffered before concurrent send was enabled, in order
+		EventPtr e;
+		while( m_concurrentQueue->tryPop( e ) )
+		{
+			bufferEvent( e );
+		}
+	}
+
+	void EventManager::bufferEvent( const EventPtr& e )
+	{
+		if( !m_coalescingRegister.empty() )
+		{
+			CoalescingRegister::iterator it = m_coalescingRegister.find( e->type() );
+			if( it != m_coalescingRegister.end() && it->second.policy != ECP_NONE )
+			{
+				coalesceEvent( e, it->second );
+				return;
+			}
+		}
 
-		// first we have to swap the current event queue with the process one (empty)
-		m_processEventQueue.clear();
-		m_processEventQueue.swap( m_eventQueue ); // ready for the next event sent
+		m_eventQueue.push_back( e );
+	}
 
-		// now we have to process each event in the processing queue
-		for( EventQueue::iterator it = m_processEventQueue.begin(); it != m_processEventQueue.end(); ++it )
+	void EventManager::coalesceEvent( const EventPtr& e, Coalescing& coalescing )
+	{
+		if( coalescing.generation != m_bufferGeneration )
 		{
-			const EventPtr e = *it;
-			GC_ASSERT_NOT_NULL( e.get() );
-			processEvent( e );
+			// nothing buffered for this type since the last process()
+			coalescing.generation = m_bufferGeneration;
+			coalescing.bufferedIndex = m_eventQueue.size();
+			coalescing.bufferedIndexByKey.clear();
+
+			if( coalescing.policy != ECP_KEEP_LAST_BY_KEY )
+			{
+				m_eventQueue.push_back( e );
+				return;
+			}
 		}
 
+		switch( coalescing.policy )
+		{
+		case ECP_KEEP_FIRST:
+			{
+				++coalescing.droppedCount;
+				break;
+			}
+		case ECP_KEEP_LAST:
+			{
+				m_eventQueue[ coalescing.bufferedIndex ] = e;
+				++coalescing.droppedCount;
+				break;
+			}
+		case ECP_MERGE:
+			{
+				EventPtr& bufferedEvent = m_eventQueue[ coalescing.bufferedIndex ];
+				EventPtr mergedEvent = coalescing.mergeFunction( bufferedEvent, e );
+				GC_ASSERT( mergedEvent && mergedEvent->type() == e->type(), "Event merge function must return an event of type " << e->type() << "!" );
+				bufferedEvent = mergedEvent;
+				++coalescing.mergedCount;
+				break;
+			}
+		case ECP_KEEP_LAST_BY_KEY:
+			{
+				const std::size_t key = coalescing.keyFunction( e );
+				std::pair< std::tr1::unordered_map< std::size_t, std::size_t >::iterator, bool > result 
+					= coalescing.bufferedIndexByKey.insert( std::make_pair( key, m_eventQueue.size() ) );
+
+				if( result.second )
+				{
+					m_eventQueue.push_back( e ); // first event with this key
+				}
+				else
+				{
+					m_eventQueue[ result.first->second ] = e;
+					++coalescing.droppedCount;
+				}
+				break;
+			}
+		default:
+			{
+				GC_ASSERT( false, "Unknown event coalescing policy!" );
+				m_eventQueue.push_back( e );
+			}
+		}
 	}
 
-	void EventManager::processEvent( const EventPtr& e )
+	EventManager::Coalescing& EventManager::coalescing( Event::TypeId type )
 	{
-		GC_ASSERT_NOT_NULL( e.get() );
+		GC_ASSERT( !type.isNull(), "Tried to coalesce null type events!" );
+
+		Coalescing& coalescing = m_coalescingRegister[ type ];
+		coalescing.generation = m_bufferGeneration - 1; // don't coalesce with events buffered before
+		return coalescing;
+	}
+
+	void EventManager::setCoalescing( Event::TypeId type, EventCoalescingPolicy policy )
+	{
+		GC_ASSERT( policy == ECP_NONE || policy == ECP_KEEP_FIRST || policy == ECP_KEEP_LAST, "Merge and keyed coalescing need a function!" );
+
+		if( policy == ECP_NONE && m_coalescingRegister.find( type ) == m_coalescingRegister.end() ) return; // be lazy!
+
+		Coalescing& typeCoalescing = coalescing( type );
+		typeCoalescing.policy = policy;
+		typeCoalescing.mergeFunction = EventMergeFunction();
+		typeCoalescing.keyFunction = EventKeyFunction();
+	}
+
+	void EventManager::setMergeCoalescing( Event::TypeId type, const EventMergeFunction& mergeFunction )
+	{
+		GC_ASSERT( mergeFunction, "Tried to set merge coalescing without merge function!" );
+
+		Coalescing& typeCoalescing = coalescing( type );
+		typeCoalescing.policy = ECP_MERGE;
+		typeCoalescing.mergeFunction = mergeFunction;
+		typeCoalescing.keyFunction = EventKeyFunction();
+	}
+
+	void EventManager::setKeyedCoalescing( Event::TypeId type, const EventKeyFunction& keyFunction )
+	{
+		GC_ASSERT( keyFunction, "Tried to set keyed coalescing without key function!" );
+
+		Coalescing& typeCoalescing = coalescing( type );
+		typeCoalescing.policy = ECP_KEEP_LAST_BY_KEY;
+		typeCoalescing.mergeFunction = EventMergeFunction();
+		typeCoalescing.keyFunction = keyFunction;
+	}
+
+	EventCoalescingPolicy EventManager::coalescingPolicy( Event::TypeId type ) const
+	{
+		CoalescingRegister::const_iterator it = m_coalescingRegister.find( type );
+		return it != m_coalescingRegister.end() ? it->second.policy : ECP_NONE;
+	}
+
+	std::size_t EventManager::droppedEventCount( Event::TypeId type ) const
+	{
+		CoalescingRegister::const_iterator it = m_coalescingRegister.find( type );
+		return it != m_coalescingRegister.end() ? it->second.droppedCount : 0;
+	}
+
+	std::size_t EventManager::mergedEventCount( Event::TypeId type ) const
+	{
+		CoalescingRegister::const_iterator it = m_coalescingRegister.find( type );
+		return it != m_coalescingRegister.end() ? it->second.mergedCount : 0;
+	}
+
+	void EventManager::resetCoalescingCounters()
+	{
+		for( CoalescingRegister::iterator it = m_coalescingRegister.begin(); it != m_coalescingRegister.end(); ++it )
+		{
+			it->second.droppedCount = 0;
+			it->second.mergedCount = 0;
+		}
+	}
 
-		if( m_listenerRegister.empty() ) return; // no listener registered at all!
+	void EventManager::enableParallelDispatch( WorkerPool& workerPool )
+	{
+		m_workerPool = &workerPool;
+	}
+
+	bool EventManager::startParallelDispatch()
+	{
+		if( m_workerPool == nullptr || m_concurrentListenerCount == 0 ) return false;
+
+		bool hasJobs = false;
+
+		// the jobs use a copy of the listener entries : removing a concurrent listener is forbidden until they are done
+
+		try
+		{
+			// listeners of all the events catch them in the processing order
+			EventListenerList& catchAllListeners = m_catchAllListeners.listeners;
+			for( EventListenerList::iterator it = catchAllListeners.begin(); it != catchAllListeners.end(); ++it )
+			{
+				if( !it->isConcurrent ) continue;
+
+				m_workerPool->push( std::tr1::bind( &EventManager::catchConcurrently, this, *it, &m_processEventQueue[0], m_processEventQueue.size() ) );
+				hasJobs = true;
+			}
+
+			// other listeners catch the events grouped by type
+			if( !m_listenerRegister.empty() )
+			{
+				EventQueue* groupedEvents = &m_processEventQueue;
+				if( !m_isBatchDispatchEnabled )
+				{
+					m_groupedEventQueue.assign( m_processEventQueue.begin(), m_processEventQueue.end() );
+					std::stable_sort( m_groupedEventQueue.begin(), m_groupedEventQueue.end(), &isEventTypeLower );
+					groupedEvents = &m_groupedEventQueue;
+				}
+
+				const std::size_t eventCount = groupedEvents->size();
+				std::size_t groupBegin = 0;
+				while( groupBegin < eventCount )
+				{
+					const std::size_t groupEnd = typeGroupEnd( *groupedEvents, groupBegin );
+
+					EventListenerRegister::iterator register_it = m_listenerRegister.find( (*groupedEvents)[ groupBegin ]->type() );
+					if( register_it != m_listenerRegister.end() )
+					{
+						EventListenerList& listeners = register_it->second.listeners;
+						for( EventListenerList::iterator it = listeners.begin(); it != listeners.end(); ++it )
+						{
+							if( !it->isConcurrent ) continue;
+
+							m_workerPool->push( std::tr1::bind( &EventManager::catchConcurrently, this, *it, &(*groupedEvents)[ groupBegin ], groupEnd - groupBegin ) );
+							hasJobs = true;
+						}
+					}
+
+					groupBegin = groupEnd;
+				}
+			}
+		}
+		catch( ... )
+		{
+			// the jobs already pushed use the processing queues : let them finish
+			if( hasJobs )
+			{
+				try { m_workerPool->wait(); }
+				catch( ... ) { ; } // the first failure is reported
+			}
+			m_groupedEventQueue.clear();
+			throw;
+		}
+
+		return hasJobs;
+	}
+
+	void EventManager::catchConcurrently( ListenerEntry entry, const EventPtr* events, std::size_t count )
+	{
+		if( entry.batchListener != nullptr )
+		{
+			entry.batchListener->catchEvents( events, count, *this ); // catch them all!
+			return;
+		}
+
+		for( std::size_t i = 0; i < count; ++i )
+		{
+			entry.listener->catchEvent( events[i], *this ); // catch!
+		}
+	}
+
+	void EventManager::processEvent( const EventPtr& e, bool skipConcurrentListeners )
+	{
+		GC_ASSERT_NOT_NULL( e.get() );
 
 		// first dispatch this event to listeners registered to listen to all events
-		EventListenerList& listenAllList = m_listenerRegister[ Event::TypeId() ];
-		dispatchEvent( e, listenAllList );
+		dispatchEvent( e, m_catchAllListeners, skipConcurrentListeners );
+
+		if( m_listenerRegister.empty() ) return; // no listener registered for specific types!
 
 		// retrieve the event listener list for this event type if it exists
 		EventListenerRegister::iterator register_it = m_listenerRegister.find( e->type() );
@@ -125,28 +694,112 @@ namespace gcore
 		if( register_it == m_listenerRegister.end() ) return; // no listeners for this event!
 		
 		// now dispatch the event to those listeners waiting for it
-		EventListenerList& listeners = register_it->second;
-		dispatchEvent( e, listeners );
+		dispatchEvent( e, register_it->second, skipConcurrentListeners );
 
 	}
 
-	void EventManager::dispatchEvent( const EventPtr& e, EventListenerList& listeners )
+	void EventManager::dispatchEvent( const EventPtr& e, ListenerTable& table, bool skipConcurrentListeners )
 	{
 		GC_ASSERT_NOT_NULL( e.get() );
 
-		if( listeners.empty() ) return; // be lazy!!
+		const std::size_t listenerCount = table.listeners.size(); // listeners added while dispatching will not catch this event
+		if( listenerCount == 0 ) return; // be lazy!!
+
+		++m_dispatchDepth;
 
-		// prepare this dispatch by copying the listener list in the one used to dispatch
-		m_processListeners.reserve( listeners.size() );
-		m_processListeners.assign( listeners.begin(), listeners.end() );
+		try
+		{
+			// ok now we have to send the event to all those catchers
+			// the list can be reallocated by listeners added while dispatching : use indices
+			for( std::size_t i = 0; i < listenerCount; ++i )
+			{
+				const ListenerEntry& entry = table.listeners[ i ];
+				if( entry.listener == nullptr ) continue; // removed while dispatching
+				if( skipConcurrentListeners && entry.isConcurrent ) continue; // caught in a job
+
+				entry.listener->catchEvent( e, *this ); // catch!
+			}
+		}
+		catch( ... )
+		{
+			endDispatch();
+			throw;
+		}
+
+		endDispatch();
+	}
+
+	void EventManager::processBatches( bool skipConcurrentListeners )
+	{
+		const std::size_t eventCount = m_processEventQueue.size();
+		std::size_t batchBegin = 0;
+		while( batchBegin < eventCount )
+		{
+			const std::size_t batchEnd = typeGroupEnd( m_processEventQueue, batchBegin );
+			const EventPtr* batch = &m_processEventQueue[ batchBegin ];
+			const std::size_t batchSize = batchEnd - batchBegin;
+
+			// same order than processEvent() : listeners of all events first
+			dispatchBatch( batch, batchSize, m_catchAllListeners, skipConcurrentListeners );
+
+			EventListenerRegister::iterator register_it = m_listenerRegister.find( m_processEventQueue[ batchBegin ]->type() );
+			if( register_it != m_listenerRegister.end() )
+			{
+				dispatchBatch( batch, batchSize, register_it->second, skipConcurrentListeners );
+			}
+
+			batchBegin = batchEnd;
+		}
+	}
+
+	void EventManager::dispatchBatch( const EventPtr* events, std::size_t count, ListenerTable& table, bool skipConcurrentListeners )
+	{
+		GC_ASSERT_NOT_NULL( events );
+
+		const std::size_t listenerCount = table.listeners.size(); // listeners added while dispatching will not catch this batch
+		if( listenerCount == 0 ) return; // be lazy!!
 
-		// ok now we have to send the event to all those catchers
-		for( EventListenerBuffer::iterator it = m_processListeners.begin(); it != m_processListeners.end(); ++it )
+		++m_dispatchDepth;
+
+		try
+		{
+			for( std::size_t i = 0; i < listenerCount; ++i )
+			{
+				if( skipConcurrentListeners && table.listeners[ i ].isConcurrent ) continue; // caught in a job
+
+				BatchEventListener* batchListener = table.listeners[ i ].batchListener;
+				if( batchListener != nullptr )
+				{
+					batchListener->catchEvents( events, count, *this ); // catch them all!
+					continue;
+				}
+
+				// one by one, until it's removed
+				for( std::size_t eventIdx = 0; eventIdx < count; ++eventIdx )
+				{
+					EventListener* listener = table.listeners[ i ].listener;
+					if( listener == nullptr ) break; // removed while dispatching
+
+					listener->catchEvent( events[ eventIdx ], *this ); // catch!
+				}
+			}
+		}
+		catch( ... )
 		{
-			EventListener* listener = *it;
-			GC_ASSERT_NOT_NULL( listener );
+			endDispatch();
+			throw;
+		}
+
+		endDispatch();
+	}
 
-			listener->catchEvent( e, *this ); // catch!
+	void EventManager::endDispatch()
+	{
+		GC_ASSERT( m_dispatchDepth > 0, "Dispatch ended while not dispatching!" );
+
+		if( --m_dispatchDepth == 0 && !m_tablesToCompact.empty() )
+		{
+			compactTables();
 		}
 	}
 }
\ No newline at end of file
@@ -4,16 +4,53 @@
 
 
 #include <unordered_map>
-#include <list>
 #include <vector>
+#include <functional>
 
 #include "GC_Common.h"
+#include "GC_ConcurrentQueue.h"
 #include "GC_Event.h"
 #include "GC_EventListener.h"
+#include "GC_EventPool.h"
+#include "GC_Time.h"
 
 
 namespace gcore	
 {
+	class Clock;
+	class WorkerPool;
+
+	/** How buffered events of the same type are coalesced before being processed.
+		@see EventManager::setCoalescing
+	*/
+	enum EventCoalescingPolicy
+	{
+		/// All the events are kept.
+		ECP_NONE = 0,
+
+		/// Only the first event sent is kept, the next ones are dropped.
+		ECP_KEEP_FIRST,
+
+		/// Only the last event sent is kept, in place of the first one.
+		ECP_KEEP_LAST,
+
+		/// The events sent are merged with the buffered one by a user function.
+		ECP_MERGE,
+
+		/// Only the last event sent is kept for each key given by a user function, in place of the first one.
+		ECP_KEEP_LAST_BY_KEY,
+	};
+
+	/** Function-like object merging an event with the buffered one of the same type.
+		@param previous Buffered event.
+		@param next Event being sent.
+		@return Event to buffer in place of the previous one.
+	*/
+	typedef std::tr1::function< EventPtr ( const EventPtr& previous, const EventPtr& next ) > EventMergeFunction;
+
+	/// Function-like object giving the key of an event, used to coalesce events with the same key (the source of the event for example).
+	typedef std::tr1::function< std::size_t ( const EventPtr& ) > EventKeyFunction;
+
 
 	/** Manage Events and EventListeners.
 
@@ -24,12 +61,33 @@ namespace gcore
 		The Event objects can be sent in two manners :
 		- immediate send : the Event will be sent to the EventListeners immediately;
 		- buffered send : the Event is registered and processed later, when EventManager::process() is called.
+		@par
+		Events can also be sent with a delay on a Clock : they are buffered by the first call to process()
+		once the Clock time advanced enough, see sendDelayed().
+		@par
+		By default the EventManager have to be used by one thread only. Once enableConcurrentSend() is called,
+		buffered sends can be done by any thread while process() is called by the owner thread.
+		@par
+		Events made with the EventPool of the EventManager don't allocate memory once the pool is warm : 
+		their memory is recycled by EventManager::process().
 
 		@remark
 		EventListener objects registered in an EventManager will 
 		have been registered to listen to the event type.
 		@remark
 		An EventListener registered to listen to a null event type will catch all events sent.
+		@remark
+		EventListeners can be added and removed while an event is dispatched : added ones will
+		catch the next events, removed ones will not catch the current event if they didn't already.
+		@remark
+		When batch dispatch is enabled, process() groups the buffered events by type, so that 
+		BatchEventListeners catch all the events of a type in one call. See enableBatchDispatch().
+		@remark
+		EventListeners that can catch events concurrently can be dispatched the buffered events
+		by a WorkerPool while the other EventListeners are dispatched them in order. See enableParallelDispatch().
+		@remark
+		Redundant buffered events of a type can be coalesced when they are sent to keep the buffered
+		events count bounded. See setCoalescing().
 
 	*/
 	class GCORE_API EventManager 
@@ -48,6 +106,11 @@ namespace gcore
 		*/
 		void addListener( EventListener& eventListener, Event::TypeId typeToCatch = Event::TypeId() );
 
+		/** Convenience version of addListener taking the name of the type : the name is hashed on each call.
+		*/
+		void addListener( EventListener& eventListener, const char* typeToCatch ) { addListener( eventListener, Event::TypeId( typeToCatch ) ); }
+		void addListener( EventListener& eventListener, const std::string& typeToCatch ) { addListener( eventListener, Event::TypeId( typeToCatch ) ); }
+
 		/** Unregister an EventListener from catching any event.
 			@param eventListener EventListener object to register.
 		*/
@@ -59,6 +122,11 @@ namespace gcore
 		*/
 		void removeListener( Event::TypeId typeToCatch, EventListener& eventListener);
 
+		/** Convenience version of removeListener taking the name of the type : the name is hashed on each call.
+		*/
+		void removeListener( const char* typeToCatch, EventListener& eventListener ) { removeListener( Event::TypeId( typeToCatch ), eventListener ); }
+		void removeListener( const std::string& typeToCatch, EventListener& eventListener ) { removeListener( Event::TypeId( typeToCatch ), eventListener ); }
+
 		/** Remove all EventListeners registered.
 		*/
 		void removeAllListeners();
@@ -69,42 +137,318 @@ namespace gcore
 		/** Send an event.
 			@remark The Event will be managed automatically via EventPtr smart pointer. It will
 			then been destroyed once there is no more reference to it.
+			@remark If concurrent send is enabled, buffered sends can be done by any thread. Immediate sends 
+			are always reserved to the owner thread.
 			@param eventToSend Event object to send.
 			@param immediate If true, the Event will be processed immediately. If false, the Event is registered and will
 			be processed on the next call of EventManager::process().
 		 */
 		void send(const EventPtr& eventToSend , bool immediate=false);
 
+		/** Send an event once a clock time advanced by a delay.
+			The event is buffered by the first process() call after the delay elapsed on the clock, so
+			pausing or slowing the clock (via it's time flow factor) delays it's events.
+			@remark The delay only counts the clock time going forward : setting back or inverting the clock time 
+			doesn't make the events wait longer than the time already elapsed.
+			@remark The events of a clock are cancelled when the clock is destroyed.
+			@remark Owner thread only.
+			@param eventToSend Event object to send.
+			@param clock Clock measuring the delay.
+			@param delay Time to wait on the clock before sending the event, in the clock time.
+		*/
+		void sendDelayed( const EventPtr& eventToSend, const Clock& clock, TimeValue delay );
+
+		/** Send an event once a clock reaches a time.
+			@see sendDelayed
+			@param eventToSend Event object to send.
+			@param clock Clock measuring the time.
+			@param time Clock time to send the event at.
+		*/
+		void sendAt( const EventPtr& eventToSend, const Clock& clock, TimeValue time );
+
+		/** Cancel the delayed events of a clock.
+		*/
+		void cancelDelayedEvents( const Clock& clock );
+
+		/** Cancel all the delayed events.
+		*/
+		void cancelAllDelayedEvents();
+
+		/// Number of delayed events not sent yet.
+		std::size_t delayedEventCount() const;
+
+		/** Set the precision of the delays, in clock time. Events can be sent up to this duration late.
+			@remark Can't be changed while delayed events are waiting.
+		*/
+		void delayedEventResolution( TimeValue resolution );
+
+		/// Precision of the delays, in clock time. One millisecond by default.
+		TimeValue delayedEventResolution() const { return m_delayedEventResolution; }
+
 		/** Process all buffered Events.
 			For each Event that have not been sent immediately, this will call
 			each EventListener::catchEvent() of EventListener registered that have the same
 			Event::TypeId than the Event sent.
 			@remark EventListeners waiting for an Event::TypeId of value 0 will receive events of all types.
+			@remark The events of the EventPool that are not referenced anymore are recycled once all the buffered events are processed.
 		*/
 		void process();
 
+		/** Set how the buffered events of a type are coalesced.
+			Coalescing is done when the events are buffered (when sent or gathered from other threads),
+			only the events buffered since the last process() are coalesced.
+			@param type Type of the events to coalesce. Must not be null.
+			@param policy ECP_NONE, ECP_KEEP_FIRST or ECP_KEEP_LAST. Use setMergeCoalescing and setKeyedCoalescing for the others.
+		*/
+		void setCoalescing( Event::TypeId type, EventCoalescingPolicy policy );
+
+		/** Merge the buffered events of a type.
+			@param type Type of the events to coalesce. Must not be null.
+			@param mergeFunction Function called with the buffered event and the one being sent, returning the event to buffer.
+		*/
+		void setMergeCoalescing( Event::TypeId type, const EventMergeFunction& mergeFunction );
+
+		/** Keep only the last buffered event of a type for each key.
+			@param type Type of the events to coalesce. Must not be null.
+			@param keyFunction Function giving the key of an event.
+		*/
+		void setKeyedCoalescing( Event::TypeId type, const EventKeyFunction& keyFunction );
+
+		/// Stop coalescing the events of a type.
+		void removeCoalescing( Event::TypeId type ) { setCoalescing( type, ECP_NONE ); }
+
+		/// How the buffered events of a type are coalesced.
+		EventCoalescingPolicy coalescingPolicy( Event::TypeId type ) const;
+
+		/// Number of events of a type dropped by coalescing since the last call to resetCoalescingCounters().
+		std::size_t droppedEventCount( Event::TypeId type ) const;
+
+		/// Number of events of a type merged in a buffered event since the last call to resetCoalescingCounters().
+		std::size_t mergedEventCount( Event::TypeId type ) const;
+
+		/// Reset the dropped and merged events counters.
+		void resetCoalescingCounters();
+
+		/** Dispatch the buffered events by type in process().
+			The buffered events are grouped by type, keeping the order of the events of each type, 
+			then each group is dispatched at once : BatchEventListeners catch the whole group in one call and
+			other EventListeners catch the events of the group one by one.
+			@remark The events of different types are not dispatched in the order they were sent anymore.
+		*/
+		void enableBatchDispatch() { m_isBatchDispatchEnabled = true; }
+
+		/** Dispatch the buffered events one by one, in the order they were sent.
+		*/
+		void disableBatchDispatch() { m_isBatchDispatchEnabled = false; }
+
+		/// True if the buffered events are dispatched by type. @see enableBatchDispatch
+		bool isBatchDispatchEnabled() const { return m_isBatchDispatchEnabled; }
+
+		/** Dispatch the buffered events to the EventListeners that can catch concurrently using a WorkerPool.
+			In process(), one job is pushed by concurrent EventListener and type of the buffered events, 
+			catching all the events of this type in the sending order (in one call for BatchEventListeners). 
+			The jobs of the EventListeners catching all the events catch all the buffered events in the processing order. 
+			Meanwhile the other EventListeners are dispatched the events in the usual order by the calling thread, 
+			then process() waits for all the jobs to be done.
+			@remark Events sent immediately are dispatched by the calling thread to all the listeners.
+			@remark Concurrent EventListeners must stay registered and alive while processing : the jobs
+			don't see them removed before all the jobs are done. They also must not use this 
+			EventManager except for buffered sends with concurrent send enabled.
+			@param workerPool WorkerPool executing the jobs, used only in process(). 
+		*/
+		void enableParallelDispatch( WorkerPool& workerPool );
+
+		/** Dispatch all the buffered events by the calling thread again.
+		*/
+		void disableParallelDispatch() { m_workerPool = nullptr; }
+
+		/// True if the concurrent EventListeners are dispatched using a WorkerPool. @see enableParallelDispatch
+		bool isParallelDispatchEnabled() const { return m_workerPool != nullptr; }
+
+		/** Allow buffered sends from any thread.
+			Buffered events are then pushed in a lock-free queue and moved in the buffered events 
+			by the owner thread in process().
+			@remark Owner thread only, while no other thread is using this EventManager.
+		*/
+		void enableConcurrentSend();
+
+		/** Reserve sends to the owner thread again. Events sent concurrently are kept for the next process().
+			@remark Owner thread only, while no other thread is using this EventManager.
+		*/
+		void disableConcurrentSend();
+
+		/// True if buffered sends can be done by any thread. @see enableConcurrentSend
+		bool isConcurrentSendEnabled() const { return m_concurrentQueue != nullptr; }
+
+		/** Pool to make the events sent to this EventManager with.
+			@remark The events made with this pool must not be referenced anymore when the EventManager is destroyed.
+			@remark Owner thread only, even if concurrent send is enabled.
+		*/
+		EventPool& eventPool() { return m_eventPool; }
+
+		/** Make a pooled simple event to send to this EventManager.
+			@param type Type of the event.
+		*/
+		EventPtr makeEvent( Event::TypeId type ) { return m_eventPool.makeEvent( type ); }
+
+		/** Convenience version of makeEvent taking the name of the type : the name is hashed on each call.
+		*/
+		EventPtr makeEvent( const char* typeName ) { return makeEvent( Event::TypeId( typeName ) ); }
+		EventPtr makeEvent( const std::string& typeName ) { return makeEvent( Event::TypeId( typeName ) ); }
+
+		/** Make a pooled data event to send to this EventManager.
+			@param type Type of the event.
+			@param data Data held by the event.
+		*/
+		template< typename DataType >
+		EventPtr makeDataEvent( Event::TypeId type, DataType data ) { return m_eventPool.makeDataEvent( type, data ); }
+
 
 	private:
 
-		typedef std::list< EventListener* > EventListenerList;
-		typedef std::vector< EventListener* > EventListenerBuffer;
-		typedef std::tr1::unordered_map< Event::TypeId, EventListenerList > EventListenerRegister;
-		typedef std::vector< const EventPtr > EventQueue;
+		/// Registered listener.
+		struct ListenerEntry
+		{
+			EventListener* listener;
+
+			/// Same listener if it can catch batches, null otherwise.
+			BatchEventListener* batchListener;
+
+			/// True if the listener can catch events concurrently.
+			bool isConcurrent;
+
+			bool operator==( const EventListener* other ) const { return listener == other; }
+		};
+
+		typedef std::vector< ListenerEntry > EventListenerList;
+
+		/** Listeners of an event type, in registration order.
+			Listeners removed while dispatching are replaced by null entries until the end of the dispatch.
+		*/
+		struct ListenerTable
+		{
+			ListenerTable() : hasRemovedListeners( false ) {}
+
+			EventListenerList listeners;
+			bool hasRemovedListeners;
+		};
+
+		typedef std::tr1::unordered_map< Event::TypeId, ListenerTable > EventListenerRegister;
+		typedef std::vector< EventPtr > EventQueue;
+
+		/// Coalescing of an event type.
+		struct Coalescing
+		{
+			Coalescing();
+
+			EventCoalescingPolicy policy;
+			EventMergeFunction mergeFunction;
+			EventKeyFunction keyFunction;
+
+			/// Buffer generation the indices are valid for.
+			unsigned int generation;
+
+			/// Index of the buffered event, if any.
+			std::size_t bufferedIndex;
+
+			/// Index of the buffered event for each key.
+			std::tr1::unordered_map< std::size_t, std::size_t > bufferedIndexByKey;
+
+			std::size_t droppedCount;
+			std::size_t mergedCount;
+		};
+
+		typedef std::tr1::unordered_map< Event::TypeId, Coalescing > CoalescingRegister;
+
+		/// Pool of the events sent to this manager. Destroyed after the event queues.
+		EventPool m_eventPool;
 
 		/// Listeners registered for each event type.
 		EventListenerRegister m_listenerRegister;
 
+		/// Listeners registered to catch all the events.
+		ListenerTable m_catchAllListeners;
+
+		/// Tables with removed listeners to compact once the dispatch is finished.
+		std::vector< ListenerTable* > m_tablesToCompact;
+
+		/// Number of dispatches in progress (nested when events are sent immediately while dispatching).
+		unsigned int m_dispatchDepth;
+
 		/// Buffered Events
 		EventQueue m_eventQueue;
 
+		/// Events sent by any thread when concurrent send is enabled, null otherwise.
+		ConcurrentQueue< EventPtr >* m_concurrentQueue;
+
 		/// Event queue used while processing events.
 		EventQueue m_processEventQueue;
 
-		/// List of listeners used while processing an event.
-		EventListenerBuffer m_processListeners;
+		/// Worker pool used to dispatch to concurrent listeners, or null.
+		WorkerPool* m_workerPool;
+
+		/// Processing queue grouped by type, for the concurrent listeners when not in batch dispatch.
+		EventQueue m_groupedEventQueue;
+
+		/// Number of registered concurrent listeners.
+		std::size_t m_concurrentListenerCount;
+
+		/// True from the start of the parallel dispatch until all it's jobs are done : the concurrent listeners can't be removed.
+		bool m_isDispatchingInParallel;
+
+		/// Coalescing of the event types that are coalesced.
+		CoalescingRegister m_coalescingRegister;
+
+		/// Incremented each time the buffered events are taken to be processed, invalidating the coalescing indices.
+		unsigned int m_bufferGeneration;
+
+		/// Events waiting for their clock, created on the first delayed send.
+		struct DelayedEvents;
+		DelayedEvents* m_delayedEvents;
+
+		/// Precision of the delays, in clock time.
+		TimeValue m_delayedEventResolution;
+
+		/// True if the buffered events are dispatched by type.
+		bool m_isBatchDispatchEnabled;
+
+		void processEvent( const EventPtr& e, bool skipConcurrentListeners );
+		void gatherConcurrentEvents();
+
+		/// Buffer the delayed events which delay elapsed.
+		void gatherDelayedEvents();
+
+		/// Add an event to the buffered events, coalescing it if necessary.
+		void bufferEvent( const EventPtr& e );
+		void coalesceEvent( const EventPtr& e, Coalescing& coalescing );
+
+		/// Coalescing of a type, created if necessary.
+		Coalescing& coalescing( Event::TypeId type );
+		void dispatchEvent( const EventPtr& e, ListenerTable& table, bool skipConcurrentListeners );
+
+		/// Dispatch the processing queue, sorted by type.
+		void processBatches( bool skipConcurrentListeners );
+		void dispatchBatch( const EventPtr* events, std::size_t count, ListenerTable& table, bool skipConcurrentListeners );
+
+		/** Push the jobs dispatching the processing queue to the concurrent listeners.
+			@return false if there is no job.
+		*/
+		bool startParallelDispatch();
+
+		/// Job dispatching events to a concurrent listener.
+		void catchConcurrently( ListenerEntry entry, const EventPtr* events, std::size_t count );
+
+		/// Remove a listener now or, while dispatching, mark it removed.
+		void removeFromTable( ListenerTable& table, EventListener& eventListener );
+
+		/// Mark all the listeners of a table removed, while dispatching.
+		void markAllRemoved( ListenerTable& table );
+
+		/// Remove the listeners marked removed.
+		void compactTables();
 
-		void processEvent( const EventPtr& e );
-		void dispatchEvent( const EventPtr& e, EventListenerList& listeners );
+		/// Leave a dispatch, compact the tables if it was the last one.
+		void endDispatch();
 
 	};
 
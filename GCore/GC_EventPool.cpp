@@ -0,0 +1,145 @@
+#include "GC_EventPool.h"
+
+namespace gcore
+{
+	namespace
+	{
+		/// Deleter of the slot pointers : the events are destroyed by the pool.
+		struct NoDelete
+		{
+			void operator()( Event* ) const {}
+		};
+	}
+
+	EventPool::EventPool()
+		: m_allocationCount( 0 )
+		, m_reuseCount( 0 )
+		, m_unpooledCount( 0 )
+	{
+	}
+
+	EventPool::~EventPool()
+	{
+		for( SlotList::iterator it = m_liveSlots.begin(); it != m_liveSlots.end(); ++it )
+		{
+			Slot* slot = *it;
+			GC_ASSERT( slot->event.unique(), "EventPool destroyed while an event of type " << slot->event->type() << " is still referenced!" );
+			slot->event->~Event();
+			freeSlot( slot );
+		}
+		m_liveSlots.clear();
+
+		shrink();
+	}
+
+	std::size_t EventPool::sizeClassOf( std::size_t eventSize )
+	{
+		std::size_t sizeClass = 0;
+		std::size_t classSize = SMALLEST_SIZE_CLASS;
+		while( sizeClass < SIZE_CLASS_COUNT && eventSize > classSize )
+		{
+			++sizeClass;
+			classSize *= 2;
+		}
+		return sizeClass;
+	}
+
+	EventPool::Slot* EventPool::acquireSlot( std::size_t sizeClass )
+	{
+		GC_ASSERT( sizeClass < SIZE_CLASS_COUNT, "Invalid event size class!" );
+
+		SlotList& freeSlots = m_freeSlots[ sizeClass ];
+		if( !freeSlots.empty() )
+		{
+			Slot* slot = freeSlots.back();
+			freeSlots.pop_back();
+			++m_reuseCount;
+			return slot;
+		}
+
+		// allocate a new slot
+		Slot* slot = new Slot();
+		slot->storage = nullptr;
+		slot->sizeClass = sizeClass;
+		try
+		{
+			slot->storage = ::operator new( SMALLEST_SIZE_CLASS << sizeClass );
+			slot->event = EventPtr( static_cast< Event* >( slot->storage ), NoDelete() );
+		}
+		catch( ... )
+		{
+			::operator delete( slot->storage );
+			delete slot;
+			throw;
+		}
+
+		++m_allocationCount;
+		return slot;
+	}
+
+	EventPtr EventPool::useSlot( Slot* slot, Event* event )
+	{
+		if( event != slot->event.get() )
+		{
+			event->~Event();
+			m_freeSlots[ slot->sizeClass ].push_back( slot );
+			return EventPtr();
+		}
+
+		m_liveSlots.push_back( slot );
+		return slot->event;
+	}
+
+	void EventPool::freeSlot( Slot* slot )
+	{
+		::operator delete( slot->storage );
+		delete slot;
+	}
+
+	void EventPool::recycle()
+	{
+		// keep the slots still referenced, in order
+		SlotList::iterator keepIt = m_liveSlots.begin();
+		for( SlotList::iterator it = m_liveSlots.begin(); it != m_liveSlots.end(); ++it )
+		{
+			Slot* slot = *it;
+			if( slot->event.unique() )
+			{
+				slot->event->~Event();
+				m_freeSlots[ slot->sizeClass ].push_back( slot );
+			}
+			else
+			{
+				*keepIt = slot;
+				++keepIt;
+			}
+		}
+		m_liveSlots.erase( keepIt, m_liveSlots.end() );
+	}
+
+	void EventPool::shrink()
+	{
+		recycle();
+
+		for( std::size_t sizeClass = 0; sizeClass < SIZE_CLASS_COUNT; ++sizeClass )
+		{
+			SlotList& freeSlots = m_freeSlots[ sizeClass ];
+			for( SlotList::iterator it = freeSlots.begin(); it != freeSlots.end(); ++it )
+			{
+				freeSlot( *it );
+			}
+			SlotList().swap( freeSlots );
+		}
+	}
+
+	std::size_t EventPool::freeSlotCount() const
+	{
+		std::size_t count = 0;
+		for( std::size_t sizeClass = 0; sizeClass < SIZE_CLASS_COUNT; ++sizeClass )
+		{
+			count += m_freeSlots[ sizeClass ].size();
+		}
+		return count;
+	}
+
+}
\ No newline at end of file
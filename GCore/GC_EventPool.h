@@ -0,0 +1,184 @@
+#ifndef GCORE_EVENTPOOL_H
+#define GCORE_EVENTPOOL_H
+#pragma once
+
+#include <vector>
+#include <new>
+
+#include "GC_Common.h"
+#include "GC_Event.h"
+#include "GC_DataEvent.h"
+
+namespace gcore
+{
+	/** Pool of Event objects, recycled to avoid allocating memory for each Event sent.
+		
+		Each event slot of the pool is allocated once with it's EventPtr and kept for the lifetime of the pool.
+		When an event is made, it is constructed in a free slot and a copy of the slot's EventPtr is returned.
+		Calling recycle() destroys the events that are not referenced anymore outside the pool 
+		and makes their slots free again, so steady event traffic doesn't allocate memory once the pool is warm.
+		@par
+		Slots are sorted in size classes, events bigger than the biggest class are allocated normally.
+		@remark Events made by the pool are destroyed on the first call to recycle() after the last reference outside
+		the pool is released, not when it is released.
+		@remark Not thread-safe : use it from the thread owning it only.
+		@remark The events made by the pool must not be referenced anymore when the pool is destroyed.
+		@see EventManager::eventPool()
+	*/
+	class GCORE_API EventPool
+	{
+	public:
+
+		/// Number of size classes.
+		static const std::size_t SIZE_CLASS_COUNT = 4;
+
+		/// Size of the smallest class, in bytes. Each class is twice the size of the previous one.
+		static const std::size_t SMALLEST_SIZE_CLASS = 32;
+
+		/// Size of the biggest class, in bytes : bigger events are not pooled.
+		static const std::size_t BIGGEST_SIZE_CLASS = SMALLEST_SIZE_CLASS << ( SIZE_CLASS_COUNT - 1 );
+
+		EventPool();
+
+		/** Destructor : destroy all the events and free the slots.
+		*/
+		~EventPool();
+
+		/** Make a pooled copy of an event.
+			@param eventModel Event to copy in the pool.
+			@return Pointer to the pooled copy.
+		*/
+		template< class EventType >
+		EventPtr make( const EventType& eventModel );
+
+		/** Make a simple pooled event.
+			@param type Type of the event.
+		*/
+		EventPtr makeEvent( Event::TypeId type ) { return make( Event( type ) ); }
+
+		/** Make a pooled data event.
+			@param type Type of the event.
+			@param data Data held by the event.
+		*/
+		template< typename DataType >
+		EventPtr makeDataEvent( Event::TypeId type, DataType data ) { return make( DataEvent< DataType >( type, data ) ); }
+
+		/** Destroy the events not referenced outside the pool anymore and make their slots available.
+			@remark EventManager::process() calls it for it's own pool once the buffered events are processed.
+		*/
+		void recycle();
+
+		/** Destroy the unused events and free all the available slots.
+		*/
+		void shrink();
+
+		/// Number of events that required memory allocation (new slots and not pooled events) since creation.
+		std::size_t allocationCount() const { return m_allocationCount; }
+
+		/// Number of events made in a reused slot since creation.
+		std::size_t reuseCount() const { return m_reuseCount; }
+
+		/// Number of events too big to be pooled made since creation.
+		std::size_t unpooledCount() const { return m_unpooledCount; }
+
+		/// Number of slots holding an event.
+		std::size_t liveEventCount() const { return m_liveSlots.size(); }
+
+		/// Number of slots available for new events.
+		std::size_t freeSlotCount() const;
+
+	private:
+
+		/// Storage of a pooled event.
+		struct Slot
+		{
+			/// Pointer owning nothing, kept to keep the reference count alive between events.
+			EventPtr event;
+
+			/// Memory the event is constructed in.
+			void* storage;
+
+			/// Size class index of the storage.
+			std::size_t sizeClass;
+		};
+
+		typedef std::vector< Slot* > SlotList;
+
+		/// Free slots of each size class.
+		SlotList m_freeSlots[ SIZE_CLASS_COUNT ];
+
+		/// Slots holding an event.
+		SlotList m_liveSlots;
+
+		std::size_t m_allocationCount;
+		std::size_t m_reuseCount;
+		std::size_t m_unpooledCount;
+
+		/// Size class of an event size, or SIZE_CLASS_COUNT if too big.
+		static std::size_t sizeClassOf( std::size_t eventSize );
+
+		/// Take a free slot or allocate a new one.
+		Slot* acquireSlot( std::size_t sizeClass );
+
+		/// Make the event of a slot live, or destroy the event and release the slot if it's not the same pointer.
+		EventPtr useSlot( Slot* slot, Event* event );
+
+		/// Free a slot, it's event have to be destroyed already.
+		void freeSlot( Slot* slot );
+
+		// non copyable
+		EventPool( const EventPool& );
+		void operator=( const EventPool& );
+
+	};
+
+	template< class EventType >
+	EventPtr EventPool::make( const EventType& eventModel )
+	{
+		const std::size_t sizeClass = sizeClassOf( sizeof( EventType ) );
+		if( sizeClass == SIZE_CLASS_COUNT )
+		{
+			++m_unpooledCount;
+			++m_allocationCount;
+			return EventPtr( new EventType( eventModel ) );
+		}
+
+		Slot* slot = acquireSlot( sizeClass );
+		EventType* event = nullptr;
+		try
+		{
+			event = new( slot->storage ) EventType( eventModel );
+		}
+		catch( ... )
+		{
+			m_freeSlots[ sizeClass ].push_back( slot );
+			throw;
+		}
+
+		EventPtr result = useSlot( slot, event );
+		if( !result )
+		{
+			// the Event part is not at the start of the object : can't be pooled
+			++m_unpooledCount;
+			++m_allocationCount;
+			result.reset( new EventType( eventModel ) );
+		}
+		return result;
+	}
+
+	/** Utility function to create a simple event with it's pointer "on the fly" using an EventPool.*/
+	inline EventPtr makeEvent( EventPool& eventPool, Event::TypeId type )
+	{
+		return eventPool.makeEvent( type );
+	}
+
+	/** Utility function to create a data event with it's pointer "on the fly" using an EventPool.*/
+	template< typename DataType >
+	EventPtr makeDataEvent( EventPool& eventPool, Event::TypeId type, DataType d )
+	{
+		return eventPool.makeDataEvent( type, d );
+	}
+
+}
+
+#endif
\ No newline at end of file
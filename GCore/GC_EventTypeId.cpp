@@ -0,0 +1,128 @@
+#include <ios>
+#include <unordered_map>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/once.hpp>
+
+#include "GC_EventTypeId.h"
+
+namespace gcore
+{
+	namespace
+	{
+#ifdef GC_DEBUG
+		/// Names of the registered type ids, protected as type ids can be created by any thread.
+		struct TypeNameRegistry
+		{
+			typedef std::tr1::unordered_map< EventTypeId::Value, std::string > NameIndex;
+
+			boost::mutex mutex;
+			NameIndex names;
+		};
+
+		TypeNameRegistry& typeNameRegistryInstance()
+		{
+			static TypeNameRegistry registry;
+			return registry;
+		}
+
+		void createTypeNameRegistry()
+		{
+			typeNameRegistryInstance();
+		}
+
+		/// Statically initialized : type ids can be created by any thread, even during the static initialization.
+		boost::once_flag typeNameRegistryFlag = BOOST_ONCE_INIT;
+
+		TypeNameRegistry& typeNameRegistry()
+		{
+			// the function-local static is not initialized in a thread-safe way by all the compilers
+			boost::call_once( &createTypeNameRegistry, typeNameRegistryFlag );
+			return typeNameRegistryInstance();
+		}
+#endif
+
+		const std::string NULL_TYPE_NAME;
+		const std::string UNKNOWN_TYPE_NAME( "<unknown event type>" );
+	}
+
+	EventTypeId::EventTypeId( const char* name )
+		: m_value( hash( name ) )
+	{
+		registerName( name );
+	}
+
+	EventTypeId::EventTypeId( const std::string& name )
+		: m_value( hash( name.c_str() ) )
+	{
+		registerName( name.c_str() );
+	}
+
+	EventTypeId::Value EventTypeId::hash( const char* name )
+	{
+		GC_ASSERT_NOT_NULL( name );
+		if( *name == '\0' ) return 0; // null type id
+
+		// FNV-1a
+		Value value = 2166136261u;
+		for( const char* c = name; *c != '\0'; ++c )
+		{
+			value ^= static_cast< unsigned char >( *c );
+			value *= 16777619u;
+		}
+		return value;
+	}
+
+	void EventTypeId::registerName( const char* name )
+	{
+		if( *name == '\0' ) return; // null type id
+
+		if( m_value == 0 )
+		{
+			GC_EXCEPTION << "Event type name collides with the null event type id! Name : " << name;
+		}
+
+#ifdef GC_DEBUG
+		TypeNameRegistry& registry = typeNameRegistry();
+		boost::mutex::scoped_lock lock( registry.mutex );
+
+		std::pair< TypeNameRegistry::NameIndex::iterator, bool > result = registry.names.insert( TypeNameRegistry::NameIndex::value_type( m_value, std::string() ) );
+		if( result.second )
+		{
+			result.first->second = name; // first registration
+		}
+		else if( result.first->second != name )
+		{
+			GC_EXCEPTION << "Event type id collision between names \"" << result.first->second << "\" and \"" << name << "\"!";
+		}
+#endif
+	}
+
+	const std::string& EventTypeId::name() const
+	{
+		if( m_value == 0 ) return NULL_TYPE_NAME;
+
+#ifdef GC_DEBUG
+		TypeNameRegistry& registry = typeNameRegistry();
+		boost::mutex::scoped_lock lock( registry.mutex );
+
+		TypeNameRegistry::NameIndex::const_iterator findIt = registry.names.find( m_value );
+		if( findIt != registry.names.end() ) return findIt->second;
+#endif
+		return UNKNOWN_TYPE_NAME;
+	}
+
+	std::ostream& operator<<( std::ostream& outputStream, const EventTypeId& typeId )
+	{
+#ifdef GC_DEBUG
+		return outputStream << typeId.name();
+#else
+		if( typeId.isNull() ) return outputStream << typeId.name();
+
+		const std::ios_base::fmtflags flags = outputStream.flags();
+		outputStream << "<event type 0x" << std::hex << typeId.value() << ">";
+		outputStream.flags( flags );
+		return outputStream;
+#endif
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+#ifndef GCORE_EVENTTYPEID_H
+#define GCORE_EVENTTYPEID_H
+#pragma once
+
+#include <string>
+#include <ostream>
+#include <functional>
+#include <boost/cstdint.hpp>
+
+#include "GC_Common.h"
+
+namespace gcore
+{
+	/** Identifier of a type of Event.
+		
+		An EventTypeId is a 32bit hash (FNV-1a) of the type name, so it is cheap to copy, compare and hash.
+		In debug builds (GC_DEBUG), the names are registered when an EventTypeId is created from a name :
+		creating two different names giving the same hash value throws an exception, and the name of an 
+		EventTypeId can be retrieved. Release builds only hash the name.
+		@par
+		The null EventTypeId (default constructed, or created from an empty name) is used to listen to all 
+		the Events in an EventManager.
+		@remark
+		Creating an EventTypeId from a name hashes the name (and locks the registry in debug builds) :
+		define the EventTypeIds once, as static constants for example, instead of creating them from names where they are used.
+		The functions taking a type name instead of an EventTypeId (makeEvent, EventManager::addListener...) are only conveniences.
+		@see Event
+	*/
+	class GCORE_API EventTypeId
+	{
+	public:
+
+		/// Hash value of a type name.
+		typedef boost::uint32_t Value;
+
+		/** Null type id. */
+		EventTypeId() : m_value( 0 ) {}
+
+		/** Type id of the provided type name.
+			@param name Name of the type, or empty for the null type id.
+		*/
+		explicit EventTypeId( const char* name );
+
+		/** Type id of the provided type name.
+			@param name Name of the type, or empty for the null type id.
+		*/
+		explicit EventTypeId( const std::string& name );
+
+		/// Hash value of this type id.
+		Value value() const { return m_value; }
+
+		/// True if this is the null type id.
+		bool isNull() const { return m_value == 0; }
+
+		/** Name this type id was created from.
+			@return The type name, or an empty string for the null type id.
+			@remark Only available in debug builds : release builds always return a placeholder name for non null type ids.
+		*/
+		const std::string& name() const;
+
+		/** Hash a type name without registering it.
+			@return Hash value of the name, 0 for an empty name.
+		*/
+		static Value hash( const char* name );
+
+		bool operator==( const EventTypeId& other ) const { return m_value == other.m_value; }
+		bool operator!=( const EventTypeId& other ) const { return m_value != other.m_value; }
+		bool operator<( const EventTypeId& other ) const { return m_value < other.m_value; }
+
+	private:
+
+		/// Hash value of the type name.
+		Value m_value;
+
+		/// Check the name doesn't collide with the null type id and, in debug builds, register it and check it doesn't collide with another one.
+		void registerName( const char* name );
+
+	};
+
+	/** Write the name of the type id in a stream, or it's hash value in release builds. */
+	GCORE_API std::ostream& operator<<( std::ostream& outputStream, const EventTypeId& typeId );
+
+}
+
+namespace std
+{
+	namespace tr1
+	{
+		/// Hash of an EventTypeId, to use it as a key in unordered containers.
+		template<>
+		struct hash< gcore::EventTypeId > : public std::unary_function< gcore::EventTypeId, std::size_t >
+		{
+			std::size_t operator()( const gcore::EventTypeId& typeId ) const { return static_cast< std::size_t >( typeId.value() ); }
+		};
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,27 @@
+#include "GC_FixedStepTask.h"
+
+namespace gcore
+{
+	FixedStepTask::FixedStepTask( const ClockManager& clockManager, TaskPriority priority /*= 0 */,const String& name /*= "" */ ) 
+		: Task( priority, name )
+		, m_clockManager( clockManager )
+		, m_substepIndex( 0 )
+	{
+
+	}
+
+	FixedStepTask::~FixedStepTask()
+	{
+
+	}
+
+	void FixedStepTask::onExecute()
+	{
+		const unsigned int substepCount = m_clockManager.getFixedSubstepCount();
+		for( m_substepIndex = 0; m_substepIndex < substepCount; ++m_substepIndex )
+		{
+			this->execute();
+		}
+		m_substepIndex = 0;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#ifndef GC_FIXEDSTEPTASK_H
+#define GC_FIXEDSTEPTASK_H
+#pragma once
+
+#include "GC_Common.h"
+#include "GC_Task.h"
+#include "GC_ClockManager.h"
+#include "GC_ProxyTask.h"
+
+namespace gcore
+{
+	/** Task that execute itself once by fixed step of a ClockManager in fixed-step mode.
+		Each cycle, it is executed ClockManager::getFixedSubstepCount() times, 
+		or not at all if no step is due.
+		@remark This task have to be executed after the Task_ClockUpdate of the ClockManager,
+		using a dependency or a lower priority for the Task_ClockUpdate.
+		@see ClockManager::setFixedStep
+	*/
+	class GCORE_API FixedStepTask 
+		: virtual public Task
+	{
+	public:
+
+		/** Constructor.
+			@param clockManager ClockManager which fixed steps this task will follow.
+			@see Task::Task
+		*/
+		FixedStepTask( const ClockManager& clockManager, TaskPriority priority = 0 ,const String& name = "" );
+
+		/** Destructor.
+		*/
+		virtual ~FixedStepTask();
+
+		/// ClockManager which fixed steps this task follow.
+		const ClockManager& clockManager() const { return m_clockManager; }
+
+		/// Duration of a step (in seconds).
+		TimeValue fixedStep() const { return m_clockManager.getFixedStep(); }
+
+		/// Index of the step being executed in the current cycle.
+		unsigned int substepIndex() const { return m_substepIndex; }
+
+	protected:
+
+		/** Execution behavior : here we execute the task once for each due fixed step.
+		*/
+		virtual void onExecute();
+
+	private:
+
+		/// ClockManager which fixed steps this task follow.
+		const ClockManager& m_clockManager;
+
+		/// Index of the step being executed in the current cycle.
+		unsigned int m_substepIndex;
+
+	};
+
+#pragma warning( push )
+#pragma warning( disable : 4250 ) // we want to use ProxyTask definitions, yes..
+
+	class FixedStepProxyTask 
+		: public ProxyTask
+		, public FixedStepTask
+	{ 
+	public:
+		FixedStepProxyTask( const ClockManager& clockManager, const TaskFunction& executeFunction
+			, const TaskFunction& onActivateFunction = &ProxyTask::emptyFunction, const TaskFunction& onTerminateFunction = &ProxyTask::emptyFunction
+			, const TaskFunction& onPausedFunction = &ProxyTask::emptyFunction, const TaskFunction& onResumedFunction = &ProxyTask::emptyFunction
+			, TaskPriority priority = 0, const String& name = "" ) 
+			: FixedStepTask( clockManager, priority, name)
+			, ProxyTask( executeFunction, onActivateFunction, onTerminateFunction, onPausedFunction, onResumedFunction, priority, name )
+		{}
+	};
+#pragma warning( pop )
+
+}
+
+#endif
\ No newline at end of file
@@ -1,9 +1,11 @@
 
 #include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/date_time/c_local_time_adjustor.hpp>
 
 #include "GC_Log.h"
 #include "GC_LogListener.h"
 #include "GC_LogManager.h"
+#include "GC_AsyncLogWriter.h"
 
 namespace gcore
 {
@@ -56,8 +58,7 @@ namespace gcore
 	void Log::logMessage( const String& message )
 	{
 		logText(); // to be sure we flush the current text if any (when "composing" a message)
-		addText( message ); 
-		logText(); // really log the message
+		if( !message.empty() ) processMessage( message ); // really log the message
 	}
 
 	void Log::addText( const String& text )
@@ -67,30 +68,30 @@ namespace gcore
 
 	void Log::logText()
 	{
-		const String& message = m_message.str();
+		const String message = m_message.str();
 
 		if( message.empty() ) return; // be lazy
 
 		// be ready for the next message
 		m_message.str( "" );
 
-		// now we can log:
-
-		using namespace boost::posix_time;
-		using namespace boost::gregorian;
-		ptime now = second_clock::local_time(); //use the clock
-
-		StringStream finalMsgStream;
-		finalMsgStream << "[" << to_simple_string( now.time_of_day() ) << "] " << message;
-		const String& finalMsg = finalMsgStream.str();
-
-		//display in console if any:
-		std::cerr << "[" << m_name << "]" << finalMsg << std::endl; 
-		std::cout << "[" << m_name << "]" << finalMsg << std::endl; 
+		processMessage( message );
+	}
 
-		//write in file :
-		m_fileStream << finalMsg << std::endl;
-		m_fileStream.flush();
+	void Log::processMessage( const String& message )
+	{
+		// now we can log:
+		AsyncLogWriter* asyncWriter = m_logManager.getAsyncWriter();
+		if( asyncWriter != nullptr )
+		{
+			// the writer thread will format and write it
+			asyncWriter->push( *this, std::time( nullptr ), message );
+		}
+		else
+		{
+			write( std::time( nullptr ), message );
+			flush();
+		}
 
 		// notify each listener registered to this log
 		if( !m_registeredListeners.empty() ) // be lazy!
@@ -110,6 +111,30 @@ namespace gcore
 		}
 	}
 
+	void Log::write( std::time_t time, const String& message )
+	{
+		using namespace boost::posix_time;
+		ptime now = boost::date_time::c_local_adjustor< ptime >::utc_to_local( from_time_t( time ) );
+
+		StringStream finalMsgStream;
+		finalMsgStream << "[" << to_simple_string( now.time_of_day() ) << "] " << message;
+		const String& finalMsg = finalMsgStream.str();
+
+		//display in console if any:
+		std::cerr << "[" << m_name << "]" << finalMsg << '\n'; 
+		std::cout << "[" << m_name << "]" << finalMsg << '\n'; 
+
+		//write in file :
+		m_fileStream << finalMsg << '\n';
+	}
+
+	void Log::flush()
+	{
+		std::cerr.flush();
+		std::cout.flush();
+		m_fileStream.flush();
+	}
+
 	LogStreamer operator<<( Log& log, const String& message )
 	{
 		return LogStreamer( log, message );
@@ -11,6 +11,7 @@
 #include <iostream>
 #include <vector>
 #include <fstream>
+#include <ctime>
 #include "GC_StringStream.h"
 #include "GC_Common.h"
 #include "GC_String.h"
@@ -20,6 +21,7 @@ namespace gcore
 
 	class LogManager;
 	class LogListener;
+	class AsyncLogWriter;
 
 
 	/** TODO : rewrite this comment!
@@ -33,6 +35,9 @@ namespace gcore
 		When the logMessage method is called thought the logMessage of the LogManager that created this Log,
 		The catchLogMessage method of every registered  LogListener of the LogManager is called.
 		However, if the logMessage of a Log is called directly, the message is written directly into the file, and LogListener are not notified.
+		@par
+		If the LogManager is in asynchronous mode, the messages are only queued : 
+		they are written in the file by the writer thread of the LogManager.
 		@remark Managed by LogManager.
 	*/
 	class GCORE_API Log
@@ -40,6 +45,7 @@ namespace gcore
 	public :
 
 		/** Write a full message into the file binded to the Log.
+			@remark In asynchronous mode, can be called by several threads if they don't use addText() at the same time.
 			@param message The message to add into the file, each message is succeeded by a new line.
 		**/
 		void logMessage( const String& message );
@@ -73,6 +79,9 @@ namespace gcore
 		/// Only LogManager should create Logs.
 		friend class LogManager;
 
+		/// Write the messages in asynchronous mode.
+		friend class AsyncLogWriter;
+
 		/// Current message being written.
 		StringStream m_message;
 
@@ -98,6 +107,20 @@ namespace gcore
 		/** The log destructor close the file in which data are written.
 		**/
 		~Log();
+
+		/** Write or queue a message, then notify the listeners.
+		*/
+		void processMessage( const String& message );
+
+		/** Format a message and write it in the console and in the file, without flushing.
+			@param time Time the message was logged.
+			@param message Message to write.
+		*/
+		void write( std::time_t time, const String& message );
+
+		/** Flush the file and the console.
+		*/
+		void flush();
 		
 					
 	};
@@ -8,6 +8,7 @@ namespace gcore
 
 	LogManager::LogManager(const String& defaultLogName)
 		: m_defaultLog( nullptr )
+		, m_asyncWriter( nullptr )
 	{
 		m_defaultLog = createLog( defaultLogName, true );
 		m_defaultLog->logMessage("LogManager initialized.");
@@ -17,6 +18,10 @@ namespace gcore
 	LogManager::~LogManager()
 	{
 		m_defaultLog->logMessage("Terminate LogManager.");
+
+		// write all the queued messages
+		disableAsyncWriting();
+
 		// Destroy all logs
 		LogIndex::iterator it;
 		for (it = m_logList.begin(); it != m_logList.end(); ++it)
@@ -115,6 +120,7 @@ namespace gcore
 	{
 		LogIndex::iterator it = m_logList.find( name );
 		GC_ASSERT( it != m_logList.end(), String( "Tried to destroy a log not created in the log manager! Log name : ") + name );
+		flush(); // the writer thread could still have messages for this log
 		delete it->second;
 		m_logList.erase( it );
 	}
@@ -170,5 +176,27 @@ namespace gcore
 		return oldlog;
 	}
 
+	void LogManager::enableAsyncWriting( std::size_t queueCapacity, LogOverflowPolicy overflowPolicy )
+	{
+		disableAsyncWriting();
+		m_asyncWriter = new AsyncLogWriter( queueCapacity, overflowPolicy );
+	}
+
+	void LogManager::disableAsyncWriting()
+	{
+		if( m_asyncWriter == nullptr ) return;
+
+		// no new message will be queued
+		AsyncLogWriter* asyncWriter = m_asyncWriter;
+		m_asyncWriter = nullptr;
+
+		delete asyncWriter; // write the queued messages
+	}
+
+	void LogManager::flush()
+	{
+		if( m_asyncWriter != nullptr ) m_asyncWriter->flush();
+	}
+
 	
 }
\ No newline at end of file
@@ -9,6 +9,7 @@
 #include "GC_String.h"
 #include "GC_Log.h"
 #include "GC_LogListener.h"
+#include "GC_AsyncLogWriter.h"
 
 
 namespace gcore
@@ -20,6 +21,10 @@ namespace gcore
 		@par
 		When deleted, every log created by the LogManager are deleted (and the opened files for logging messages are closed
 		LogListener are not deleted.
+		@par
+		In asynchronous mode, the logging threads only queue the messages : an AsyncLogWriter 
+		write them in the files from it's own thread. LogListeners are still notified by the logging thread.
+		@see enableAsyncWriting
 			
 	*/
 	class GCORE_API LogManager 
@@ -95,6 +100,29 @@ namespace gcore
 		*/
 		Log* setDefaultLog( Log* log );
 
+		/** Switch to asynchronous mode : the messages are written by a dedicated thread.
+			If the asynchronous mode is already enabled, the queued messages are written first.
+			@param queueCapacity Maximum number of messages waiting to be written.
+			@param overflowPolicy What to do with the messages logged while the queue is full.
+			@remark No thread can log while switching the mode.
+			@see AsyncLogWriter
+		*/
+		void enableAsyncWriting( std::size_t queueCapacity = 4096, LogOverflowPolicy overflowPolicy = LOP_BLOCK );
+
+		/** Switch back to synchronous mode, after writing the queued messages.
+			@remark No thread can log while switching the mode.
+		*/
+		void disableAsyncWriting();
+
+		/** Writer of the messages in asynchronous mode, or null in synchronous mode.
+		*/
+		AsyncLogWriter* getAsyncWriter() const { return m_asyncWriter; }
+
+		/** Wait until all the logged messages are written in the files.
+			Does nothing in synchronous mode : messages are written immediately.
+		*/
+		void flush();
+
 	
 	private:
 
@@ -105,6 +133,9 @@ namespace gcore
 
 		/// Default Log : 
 		Log* m_defaultLog;
+
+		/// Writer of the messages in asynchronous mode, or null in synchronous mode.
+		AsyncLogWriter* m_asyncWriter;
 		
 	};
 
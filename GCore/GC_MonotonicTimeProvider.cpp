@@ -0,0 +1,59 @@
+#include "GC_MonotonicTimeProvider.h"
+
+#if GC_PLATFORM == GC_PLATFORM_WIN32
+	#ifndef WIN32_LEAN_AND_MEAN
+		#define WIN32_LEAN_AND_MEAN
+	#endif
+	#include <windows.h>
+#else
+	#include <time.h>
+#endif
+
+namespace gcore
+{
+
+	MonotonicTimeProvider::MonotonicTimeProvider()
+		: TimeReferenceProvider()
+		, m_startTicks( readTicks() )
+		, m_ticksPerSecond( readTicksPerSecond() )
+	{
+	}
+
+	TimeValue MonotonicTimeProvider::getTimeSinceStart() const
+	{
+		return static_cast< TimeValue >( getTicksSinceStart() ) / static_cast< TimeValue >( m_ticksPerSecond );
+	}
+
+#if GC_PLATFORM == GC_PLATFORM_WIN32
+
+	TimeTicks MonotonicTimeProvider::readTicks()
+	{
+		LARGE_INTEGER counter;
+		QueryPerformanceCounter( &counter );
+		return counter.QuadPart;
+	}
+
+	TimeTicks MonotonicTimeProvider::readTicksPerSecond()
+	{
+		LARGE_INTEGER frequency;
+		QueryPerformanceFrequency( &frequency );
+		return frequency.QuadPart;
+	}
+
+#else
+
+	TimeTicks MonotonicTimeProvider::readTicks()
+	{
+		timespec now;
+		clock_gettime( CLOCK_MONOTONIC, &now );
+		return static_cast< TimeTicks >( now.tv_sec ) * 1000000000 + now.tv_nsec;
+	}
+
+	TimeTicks MonotonicTimeProvider::readTicksPerSecond()
+	{
+		return 1000000000;
+	}
+
+#endif
+
+}
\ No newline at end of file
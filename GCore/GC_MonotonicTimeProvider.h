@@ -0,0 +1,60 @@
+#ifndef GCORE_MONOTONICTIMEPROVIDER_H
+#define GCORE_MONOTONICTIMEPROVIDER_H
+#pragma once
+
+#include "GC_Common.h"
+#include "GC_TimeReferenceProvider.h"
+
+namespace gcore
+{
+
+	/** Provide time from the monotonic clock of the system : it never goes back and is not 
+		affected by changes of the system time.
+		Uses QueryPerformanceCounter() on Windows and clock_gettime( CLOCK_MONOTONIC ) on other platforms.
+		@remark The start time is the creation of the provider.
+	*/
+	class GCORE_API MonotonicTimeProvider : public TimeReferenceProvider
+	{
+	public:
+
+		/** Constructor.
+		*/
+		MonotonicTimeProvider();
+
+		/** Destructor.
+		*/
+		~MonotonicTimeProvider(){}
+
+		/** Time passed since the creation of this provider.
+			@return Time value (in seconds).
+		*/
+		TimeValue getTimeSinceStart() const;
+
+		/** Ticks passed since the creation of this provider.
+			@return Time value (in ticks).
+		*/
+		TimeTicks getTicksSinceStart() const { return readTicks() - m_startTicks; }
+
+		/** Number of ticks in a second : the frequency of the performance counter on Windows, nanoseconds on other platforms.
+		*/
+		TimeTicks getTicksPerSecond() const { return m_ticksPerSecond; }
+
+	private:
+
+		/// Ticks of the system monotonic clock on creation.
+		const TimeTicks m_startTicks;
+
+		/// Number of ticks in a second.
+		const TimeTicks m_ticksPerSecond;
+
+		/// Current ticks of the system monotonic clock.
+		static TimeTicks readTicks();
+
+		/// Number of ticks of the system monotonic clock in a second.
+		static TimeTicks readTicksPerSecond();
+
+	};
+
+}
+
+#endif
\ No newline at end of file
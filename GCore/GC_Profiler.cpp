@@ -8,7 +8,8 @@ namespace gcore
 	
 
 	Profiler::Profiler( const TimeReferenceProvider& timeReference  , unsigned long maxRecordCount) 
-		: m_lastRecordTime( 0 )
+		: m_lastRecordTicks( 0 )
+		, m_isStarted( false )
 		, m_timeReference( timeReference )
 		, m_maxRecordCount( maxRecordCount )
 	{
@@ -32,16 +33,17 @@ namespace gcore
 
 	void Profiler::start()
 	{
-		m_lastRecordTime = m_timeReference.getTimeSinceStart();
+		m_lastRecordTicks = m_timeReference.getTicksSinceStart();
+		m_isStarted = true;
 	}
 
 	gcore::TimeValue Profiler::stop()
 	{
-		if( m_lastRecordTime != 0 )
+		if( m_isStarted )
 		{
 			// record the time span since last record
-			const TimeValue currentTime( m_timeReference.getTimeSinceStart() );
-			const TimeValue spanTime( currentTime - m_lastRecordTime );
+			const TimeTicks currentTicks( m_timeReference.getTicksSinceStart() );
+			const TimeValue spanTime( m_timeReference.ticksToTime( currentTicks - m_lastRecordTicks ) );
 
 			if( m_maxRecordCount == 0 ) // we have no record limit
 			{
@@ -57,7 +59,7 @@ namespace gcore
 			}
 
 			// update the last record time
-			m_lastRecordTime = currentTime; 
+			m_lastRecordTicks = currentTicks; 
 
 			return spanTime;
 		}
@@ -69,7 +71,7 @@ namespace gcore
 
 	TimeValue Profiler::record()
 	{
-		if( m_lastRecordTime != 0 )
+		if( m_isStarted )
 		{
 			return stop();
 		}
@@ -148,7 +150,7 @@ namespace gcore
 
 	void Profiler::clear()
 	{
-		m_lastRecordTime = 0;
+		m_isStarted = false;
 		m_timeSpans.clear();
 	}
 
@@ -10,6 +10,8 @@ namespace gcore
 {
 	
 	/** Simple time profiling tool. 
+		Time spans are measured in ticks of the time reference provider, then converted :
+		they keep the precision of the provider even after a long run time.
 	*/
 	class GCORE_API Profiler
 	{
@@ -99,8 +101,11 @@ namespace gcore
 		/// Recorded time spans.
 		TimeSpanList m_timeSpans;
 
-		/// Time value on the last time span record.
-		TimeValue m_lastRecordTime;
+		/// Time value on the last time span record (in ticks).
+		TimeTicks m_lastRecordTicks;
+
+		/// True if start() or record() was called since the creation or the last clear().
+		bool m_isStarted;
 
 		/// Time reference provider used to record time spans.
 		const TimeReferenceProvider& m_timeReference;
@@ -0,0 +1,56 @@
+#include "GC_RecordingTimeProvider.h"
+#include "GC_TimeRecordFormat.h"
+
+namespace gcore
+{
+
+	RecordingTimeProvider::RecordingTimeProvider( const TimeReferenceProvider& source, std::ostream& stream )
+		: TimeReferenceProvider()
+		, m_source( source )
+		, m_ticksPerSecond( source.getTicksPerSecond() )
+		, m_stream( stream )
+		, m_recordCount( 0 )
+	{
+		m_lastValues[ TRK_TIME ] = 0;
+		m_lastValues[ TRK_TICKS ] = 0;
+
+		m_stream.write( TIME_RECORD_MAGIC, sizeof( TIME_RECORD_MAGIC ) );
+		m_stream.put( static_cast< char >( TIME_RECORD_VERSION ) );
+		if( !writeVarint( m_stream, static_cast< boost::uint64_t >( m_ticksPerSecond ) ) )
+		{
+			GC_EXCEPTION << "Failed to write the header of a time record!";
+		}
+	}
+
+	TimeValue RecordingTimeProvider::getTimeSinceStart() const
+	{
+		boost::mutex::scoped_lock lock( m_mutex );
+
+		const TimeValue timeValue = m_source.getTimeSinceStart();
+		record( TRK_TIME, timeValueBits( timeValue ) );
+		return timeValue;
+	}
+
+	TimeTicks RecordingTimeProvider::getTicksSinceStart() const
+	{
+		boost::mutex::scoped_lock lock( m_mutex );
+
+		const TimeTicks ticks = m_source.getTicksSinceStart();
+		record( TRK_TICKS, static_cast< boost::uint64_t >( ticks ) );
+		return ticks;
+	}
+
+	void RecordingTimeProvider::record( unsigned int kind, boost::uint64_t value ) const
+	{
+		// unsigned difference : wraps instead of overflowing
+		const boost::uint64_t difference = value - m_lastValues[ kind ];
+		if( !writeVarint( m_stream, zigzagEncode( difference ), 6, static_cast< unsigned char >( kind << 6 ) ) )
+		{
+			GC_EXCEPTION << "Failed to write a time record! Records written : " << m_recordCount;
+		}
+
+		m_lastValues[ kind ] = value;
+		++m_recordCount;
+	}
+
+}
\ No newline at end of file
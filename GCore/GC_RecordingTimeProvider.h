@@ -0,0 +1,81 @@
+#ifndef GCORE_RECORDINGTIMEPROVIDER_H
+#define GCORE_RECORDINGTIMEPROVIDER_H
+#pragma once
+
+#include <ostream>
+#include <boost/cstdint.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include "GC_Common.h"
+#include "GC_TimeReferenceProvider.h"
+
+namespace gcore
+{
+
+	/** Provide the time of another provider and record every query in a compact binary stream,
+		to replay the exact same times with a ReplayTimeProvider.
+		Used to reproduce a run, for example to get stable profiling baselines.
+		@remark Queries are recorded in the order they are done : to replay a run bit-identically, 
+		the queries have to be done in the same order, so from one thread or in a deterministic way.
+		@remark The stream is written on each query : flush it once the recording is done.
+		@see ReplayTimeProvider @see GC_TimeRecordFormat.h
+	*/
+	class GCORE_API RecordingTimeProvider : public TimeReferenceProvider
+	{
+	public:
+
+		/** Constructor : write the header of the record.
+			@param source Provider of the recorded time.
+			@param stream Binary stream to record the queries in.
+		*/
+		RecordingTimeProvider( const TimeReferenceProvider& source, std::ostream& stream );
+
+		/** Destructor.
+		*/
+		~RecordingTimeProvider(){}
+
+		/** Time of the source provider, recorded.
+			@return Time value (in seconds).
+		*/
+		TimeValue getTimeSinceStart() const;
+
+		/** Ticks of the source provider, recorded.
+			@return Time value (in ticks).
+		*/
+		TimeTicks getTicksSinceStart() const;
+
+		/** Number of ticks in a second of the source provider.
+		*/
+		TimeTicks getTicksPerSecond() const { return m_ticksPerSecond; }
+
+		/// Number of queries recorded.
+		unsigned long recordCount() const { return m_recordCount; }
+
+	private:
+
+		/// Provider of the recorded time.
+		const TimeReferenceProvider& m_source;
+
+		/// Number of ticks in a second of the source provider.
+		const TimeTicks m_ticksPerSecond;
+
+		/// Stream to record the queries in.
+		std::ostream& m_stream;
+
+		/// Values of the last queries of each kind, recorded as differences.
+		mutable boost::uint64_t m_lastValues[2];
+
+		/// Number of queries recorded.
+		mutable unsigned long m_recordCount;
+
+		/// Protect the stream from queries of different threads.
+		mutable boost::mutex m_mutex;
+
+		/// Record a query.
+		void record( unsigned int kind, boost::uint64_t value ) const;
+
+	};
+
+}
+
+#endif
\ No newline at end of file
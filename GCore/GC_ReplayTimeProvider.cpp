@@ -0,0 +1,84 @@
+#include "GC_ReplayTimeProvider.h"
+#include "GC_TimeRecordFormat.h"
+
+namespace gcore
+{
+
+	ReplayTimeProvider::ReplayTimeProvider( std::istream& stream )
+		: TimeReferenceProvider()
+		, m_stream( stream )
+		, m_ticksPerSecond( 0 )
+		, m_replayCount( 0 )
+	{
+		m_lastValues[ TRK_TIME ] = 0;
+		m_lastValues[ TRK_TICKS ] = 0;
+
+		char magic[ sizeof( TIME_RECORD_MAGIC ) ];
+		m_stream.read( magic, sizeof( magic ) );
+		if( m_stream.gcount() != sizeof( magic ) || std::memcmp( magic, TIME_RECORD_MAGIC, sizeof( magic ) ) != 0 )
+		{
+			GC_EXCEPTION << "Tried to replay a stream that is not a time record!";
+		}
+
+		const int version = m_stream.get();
+		if( version != TIME_RECORD_VERSION )
+		{
+			GC_EXCEPTION << "Tried to replay a time record of unsupported version " << version << " (supported version : " << int( TIME_RECORD_VERSION ) << ")!";
+		}
+
+		const int firstByte = m_stream.get();
+		boost::uint64_t ticksPerSecond = 0;
+		if( firstByte == std::char_traits< char >::eof() 
+			|| !readVarint( m_stream, static_cast< unsigned char >( firstByte ), ticksPerSecond ) 
+			|| ticksPerSecond == 0 )
+		{
+			GC_EXCEPTION << "Failed to read the header of a time record!";
+		}
+		m_ticksPerSecond = static_cast< TimeTicks >( ticksPerSecond );
+	}
+
+	TimeValue ReplayTimeProvider::getTimeSinceStart() const
+	{
+		boost::mutex::scoped_lock lock( m_mutex );
+		return timeValueFromBits( replay( TRK_TIME ) );
+	}
+
+	TimeTicks ReplayTimeProvider::getTicksSinceStart() const
+	{
+		boost::mutex::scoped_lock lock( m_mutex );
+		return static_cast< TimeTicks >( replay( TRK_TICKS ) );
+	}
+
+	bool ReplayTimeProvider::isFinished() const
+	{
+		boost::mutex::scoped_lock lock( m_mutex );
+		return m_stream.peek() == std::char_traits< char >::eof();
+	}
+
+	boost::uint64_t ReplayTimeProvider::replay( unsigned int kind ) const
+	{
+		const int firstByte = m_stream.get();
+		if( firstByte == std::char_traits< char >::eof() )
+		{
+			GC_EXCEPTION << "Time record finished! Queries replayed : " << m_replayCount;
+		}
+
+		const unsigned int recordKind = ( firstByte >> 6 ) & 1;
+		if( recordKind != kind )
+		{
+			GC_EXCEPTION << "Replayed run diverged from the time record : query " << m_replayCount 
+				<< ( kind == TRK_TIME ? " asked time" : " asked ticks" ) << " but " << ( recordKind == TRK_TIME ? "time" : "ticks" ) << " was recorded!";
+		}
+
+		boost::uint64_t value = 0;
+		if( !readVarint( m_stream, static_cast< unsigned char >( firstByte ), value, 6 ) )
+		{
+			GC_EXCEPTION << "Invalid time record! Queries replayed : " << m_replayCount;
+		}
+
+		m_lastValues[ kind ] += zigzagDecode( value );
+		++m_replayCount;
+		return m_lastValues[ kind ];
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#ifndef GCORE_REPLAYTIMEPROVIDER_H
+#define GCORE_REPLAYTIMEPROVIDER_H
+#pragma once
+
+#include <istream>
+#include <boost/cstdint.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include "GC_Common.h"
+#include "GC_TimeReferenceProvider.h"
+
+namespace gcore
+{
+
+	/** Provide the times recorded by a RecordingTimeProvider, in the order they were queried.
+		Replaying a run with the same queries in the same order gives bit-identical times.
+		@remark An exception occurs if the record is finished or if a query is not the one 
+		that was recorded at this place : the replayed run diverged from the recorded one.
+		@see RecordingTimeProvider @see GC_TimeRecordFormat.h
+	*/
+	class GCORE_API ReplayTimeProvider : public TimeReferenceProvider
+	{
+	public:
+
+		/** Constructor : read the header of the record.
+			An exception occurs if the stream is not a time record.
+			@param stream Binary stream written by a RecordingTimeProvider.
+		*/
+		explicit ReplayTimeProvider( std::istream& stream );
+
+		/** Destructor.
+		*/
+		~ReplayTimeProvider(){}
+
+		/** Next recorded time.
+			@return Time value (in seconds).
+		*/
+		TimeValue getTimeSinceStart() const;
+
+		/** Next recorded ticks.
+			@return Time value (in ticks).
+		*/
+		TimeTicks getTicksSinceStart() const;
+
+		/** Number of ticks in a second of the recorded provider.
+		*/
+		TimeTicks getTicksPerSecond() const { return m_ticksPerSecond; }
+
+		/// Number of queries replayed.
+		unsigned long replayCount() const { return m_replayCount; }
+
+		/// True if all the recorded queries have been replayed.
+		bool isFinished() const;
+
+	private:
+
+		/// Stream to read the records from.
+		std::istream& m_stream;
+
+		/// Number of ticks in a second of the recorded provider.
+		TimeTicks m_ticksPerSecond;
+
+		/// Values of the last queries of each kind, recorded as differences.
+		mutable boost::uint64_t m_lastValues[2];
+
+		/// Number of queries replayed.
+		mutable unsigned long m_replayCount;
+
+		/// Protect the stream from queries of different threads.
+		mutable boost::mutex m_mutex;
+
+		/// Read the next record, that have to be of the given kind.
+		boost::uint64_t replay( unsigned int kind ) const;
+
+	};
+
+}
+
+#endif
\ No newline at end of file
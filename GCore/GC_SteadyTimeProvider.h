@@ -0,0 +1,62 @@
+#ifndef GCORE_STEADYTIMEPROVIDER_H
+#define GCORE_STEADYTIMEPROVIDER_H
+#pragma once
+
+#include <boost/chrono.hpp>
+
+#include "GC_Common.h"
+#include "GC_TimeReferenceProvider.h"
+
+namespace gcore
+{
+
+	/** Provide time from boost::chrono::steady_clock, the portable monotonic clock.
+		@remark The start time is the creation of the provider.
+		@remark Ticks are nanoseconds.
+	*/
+	class GCORE_API SteadyTimeProvider : public TimeReferenceProvider
+	{
+	public:
+
+		/** Constructor.
+		*/
+		SteadyTimeProvider()
+			: TimeReferenceProvider()
+			, m_startTime( boost::chrono::steady_clock::now() )
+		{
+		}
+
+		/** Destructor.
+		*/
+		~SteadyTimeProvider(){}
+
+		/** Time passed since the creation of this provider.
+			@return Time value (in seconds).
+		*/
+		TimeValue getTimeSinceStart() const
+		{
+			return static_cast< TimeValue >( getTicksSinceStart() ) / 1000000000.0;
+		}
+
+		/** Nanoseconds passed since the creation of this provider.
+			@return Time value (in ticks).
+		*/
+		TimeTicks getTicksSinceStart() const
+		{
+			return boost::chrono::duration_cast< boost::chrono::nanoseconds >( boost::chrono::steady_clock::now() - m_startTime ).count();
+		}
+
+		/** Number of ticks in a second : ticks are nanoseconds.
+		*/
+		TimeTicks getTicksPerSecond() const { return 1000000000; }
+
+	private:
+
+		/// Time of the creation of this provider.
+		const boost::chrono::steady_clock::time_point m_startTime;
+
+	};
+
+}
+
+#endif
\ No newline at end of file
@@ -7,7 +7,15 @@ namespace gcore
 	Task::Task( TaskPriority priority /*= 0 */,const String& name /*= "" */ ) : m_name( name ), 
 		m_priority( priority ), 
 		m_state( TS_UNREGISTERED ),
-		m_taskManager( nullptr )
+		m_taskManager( nullptr ),
+		m_executionIndex( TaskManager::INVALID_INDEX ),
+		m_registeredIndex( TaskManager::INVALID_INDEX ),
+		m_stateListIndex( TaskManager::INVALID_INDEX ),
+		m_pendingExecutionIndex( TaskManager::INVALID_INDEX ),
+		m_activationOrder( 0 ),
+		m_profile( nullptr ),
+		m_deferralCount( 0 ),
+		m_consecutiveDeferralCount( 0 )
 	{
 
 	}
@@ -57,6 +65,18 @@ namespace gcore
 		m_taskManager->unregisterTask( this );
 	}
 
+	void Task::addDependency( Task* dependency )
+	{
+		GC_ASSERT( m_taskManager != nullptr , "Tried to add a dependency to an unregistered Task! : null TaskManager !" );  
+		m_taskManager->addTaskDependency( this, dependency );
+	}
+
+	void Task::removeDependency( Task* dependency )
+	{
+		GC_ASSERT( m_taskManager != nullptr , "Tried to remove a dependency from an unregistered Task! : null TaskManager !" );  
+		m_taskManager->removeTaskDependency( this, dependency );
+	}
+
 	void Task::priority( const TaskPriority& priority )
 	{
 		if( m_taskManager != nullptr ) m_taskManager->changeTaskPriority( this, priority );
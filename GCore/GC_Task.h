@@ -3,6 +3,8 @@
 #pragma once
 
 
+#include <vector>
+
 #include "GC_Common.h"
 #include "GC_String.h"
 
@@ -12,6 +14,7 @@
 namespace gcore
 {
 	class TaskManager;
+	class TaskProfile;
 	
 	/** A Task is an iterative process that should be executed by
 		a TaskManager each cycle of a loop. The purpose is
@@ -91,6 +94,30 @@ namespace gcore
 		*/
 		void unregister();
 
+		/** Make this Task execute after the provided Task each cycle.
+			@remark This is a proxy function for TaskManager::addTaskDependency().
+			@see TaskManager::addTaskDependency
+		*/
+		void addDependency( Task* dependency );
+
+		/** Remove a dependency added with addDependency().
+			@remark This is a proxy function for TaskManager::removeTaskDependency().
+			@see TaskManager::removeTaskDependency
+		*/
+		void removeDependency( Task* dependency );
+
+		/// Tasks that have to be executed before this one.
+		const std::vector< Task* >& dependencies() const { return m_dependencies; }
+
+		/// Tasks that have to be executed after this one.
+		const std::vector< Task* >& dependentTasks() const { return m_dependentTasks; }
+
+		/// Number of times this Task was not executed because the frame deadline of it's TaskManager was reached. @see TaskManager::setFrameDeadline
+		unsigned long deferralCount() const { return m_deferralCount; }
+
+		/// Number of the last executeTasks calls in a row that deferred this Task.
+		unsigned long consecutiveDeferralCount() const { return m_consecutiveDeferralCount; }
+
 		//////////////////////////
 
 		/** Change the current priority value of this Task.
@@ -180,6 +207,36 @@ namespace gcore
 		/// Current manager of the Task or null if not registered.
 		TaskManager* m_taskManager;
 
+		/// Tasks that have to be executed before this one.
+		std::vector< Task* > m_dependencies;
+
+		/// Tasks that have to be executed after this one.
+		std::vector< Task* > m_dependentTasks;
+
+		/// Index of this Task in the execution list of it's TaskManager, valid only while active.
+		std::size_t m_executionIndex;
+
+		/// Index of this Task in the registered list of it's TaskManager.
+		std::size_t m_registeredIndex;
+
+		/// Index of this Task in the active or paused list of it's TaskManager, depending on it's state.
+		std::size_t m_stateListIndex;
+
+		/// Index of this Task in the list of tasks to add in the execution list, or TaskManager::INVALID_INDEX.
+		std::size_t m_pendingExecutionIndex;
+
+		/// Activation (or resume) order, used to keep the order of Tasks with the same priority.
+		unsigned long m_activationOrder;
+
+		/// Execution time statistics, or null if the TaskManager doesn't profile the tasks.
+		TaskProfile* m_profile;
+
+		/// Number of times this Task was deferred by a frame deadline.
+		unsigned long m_deferralCount;
+
+		/// Number of the last executions in a row that deferred this Task.
+		unsigned long m_consecutiveDeferralCount;
+
 	};
 
 
@@ -1,7 +1,15 @@
 #include <algorithm>
+#include <functional>
+#include <iterator>
+#include <queue>
+#include <set>
+#include <boost/pool/object_pool.hpp>
+#include "GC_StringStream.h"
 #include "GC_Exception.h"
+#include "GC_TimeReferenceProvider.h"
 #include "GC_Task.h"
 #include "GC_TaskManager.h"
+#include "GC_WorkerPool.h"
 
 
 namespace gcore
@@ -11,12 +19,67 @@ namespace gcore
 	*/
 	bool TaskManager::TaskCompare_AscendingPriority::operator ()(Task* a1, Task* a2) const 
 	{ 
-		return a1->priority() < a2->priority(); 
+		if( a1->priority() != a2->priority() ) return a1->priority() < a2->priority(); 
+		return a1->m_activationOrder < a2->m_activationOrder; // keep the activation order for the same priority
 	} 
 
+	void TaskManager::insertInList( TaskList& taskList, Task* task, std::size_t Task::* taskIndex )
+	{
+		GC_ASSERT( task->*taskIndex == INVALID_INDEX, "Tried to insert a task already in the list! Task : " << task->name() );
+		task->*taskIndex = taskList.size();
+		taskList.push_back( task );
+	}
+
+	void TaskManager::removeFromList( TaskList& taskList, Task* task, std::size_t Task::* taskIndex )
+	{
+		const std::size_t index = task->*taskIndex;
+		GC_ASSERT( index < taskList.size() && taskList[ index ] == task, "Tried to remove a task not in the list! Task : " << task->name() );
+
+		// the last task of the list takes the place of the removed one
+		Task* lastTask = taskList.back();
+		taskList[ index ] = lastTask;
+		lastTask->*taskIndex = index;
+		taskList.pop_back();
+
+		task->*taskIndex = INVALID_INDEX;
+	}
+
+	bool TaskManager::isRegisteredHere( const Task* task ) const
+	{
+		return task->m_registeredIndex < m_registeredTasksList.size() && m_registeredTasksList[ task->m_registeredIndex ] == task;
+	}
+
+	void TaskManager::scheduleExecution( Task* task )
+	{
+		task->m_activationOrder = ++m_activationCount;
+		if( task->m_pendingExecutionIndex == INVALID_INDEX )
+		{
+			insertInList( m_pendingExecutionTasks, task, &Task::m_pendingExecutionIndex );
+		}
+
+		// we'll need to update the execution list before the next tasks execution
+		m_activeListChanged = true;
+	}
+
 
 	TaskManager::TaskManager()
-		: m_activeListChanged( false )
+		: m_removedExecutionTaskCount( 0 )
+		, m_activationCount( 0 )
+		, m_executionListSorted( true )
+		, m_graphPendingDependenciesSize( 0 )
+		, m_dependencyCount( 0 )
+		, m_activeListChanged( false )
+		, m_executionMode( TEM_SEQUENTIAL )
+		, m_workerPool( nullptr )
+		, m_profilingTimeReference( nullptr )
+		, m_taskProfilePool( new TaskProfilePool() )
+		, m_isExecutingTasks( false )
+		, m_deadlineTimeReference( nullptr )
+		, m_frameBudget( 0 )
+		, m_deferrablePriority( 0 )
+		, m_firstDeferrableIndex( 0 )
+		, m_firstDeferredIndex( INVALID_INDEX )
+		, m_deferredTaskCount( 0 )
 	{
 		
 	}
@@ -24,19 +87,21 @@ namespace gcore
 	TaskManager::~TaskManager()
 	{
 		unregisterAllTasks();
+		delete m_taskProfilePool;
 	}
 
 	void TaskManager::registerTask( Task* task )
 	{
 		//task not null
 		GC_ASSERT( task != nullptr, "Tried to register a null task!" );
+		StateLock lock( m_stateMutex );
 		//task not already registered
 		if( task->m_state != TS_UNREGISTERED || task->m_taskManager != nullptr )
 		{
 			GC_EXCEPTION << "Tried to register an already registered task! Task : " << task->name();
 		}
 
-		GC_ASSERT( std::find( m_registeredTasksList.begin(), m_registeredTasksList.end(), task) == m_registeredTasksList.end() , "Tried to activate task already registered in this TaskManager! Task : " << task->name() )
+		GC_ASSERT( !isRegisteredHere( task ) , "Tried to activate task already registered in this TaskManager! Task : " << task->name() );
 
 		//////////////////////////////////////////////////////////////////////////
 
@@ -53,7 +118,12 @@ namespace gcore
 		}
 
 		// register the task
-		m_registeredTasksList.push_back( task );
+		insertInList( m_registeredTasksList, task, &Task::m_registeredIndex );
+
+		if( isTaskProfilingEnabled() )
+		{
+			task->m_profile = m_taskProfilePool->construct();
+		}
 
 		// change the task state
 		task->m_state = TS_REGISTERED;
@@ -65,6 +135,7 @@ namespace gcore
 	{
 		// task not null
 		GC_ASSERT( task != nullptr, "Tried to register a null task!" );
+		StateLock lock( m_stateMutex );
 		// task must be registered here
 		if( task->m_state == TS_UNREGISTERED || task->m_taskManager != this )
 		{
@@ -80,6 +151,9 @@ namespace gcore
 			terminateTask( task );
 		}
 
+		// forget the dependencies of this task
+		removeAllTaskDependencies( task );
+
 		//remove task name from index if not empty
 		if( task->name() != "" )
 		{
@@ -87,7 +161,13 @@ namespace gcore
 		}
 
 		// now we can unregister the task
-		m_registeredTasksList.remove( task );
+		removeFromList( m_registeredTasksList, task, &Task::m_registeredIndex );
+
+		if( task->m_profile != nullptr )
+		{
+			destroyProfile( task->m_profile );
+			task->m_profile = nullptr;
+		}
 
 		// change the task state
 		task->m_state = TS_UNREGISTERED;
@@ -99,6 +179,7 @@ namespace gcore
 	{
 		//task not null
 		GC_ASSERT( task != nullptr , "Tried to activate a null task!" );
+		StateLock lock( m_stateMutex );
 
 		// check : task registered here!
 		if( task->m_taskManager != this )
@@ -112,13 +193,13 @@ namespace gcore
 			GC_EXCEPTION << "Tried to activate task already registered or paused! Task : " << task->name() ;
 		}
 
-		GC_ASSERT( std::find( m_registeredTasksList.begin(), m_registeredTasksList.end(), task) != m_registeredTasksList.end() , "Tried to activate task not registered in this TaskManager! Task : " << task->name() )
+		GC_ASSERT( isRegisteredHere( task ) , "Tried to activate task not registered in this TaskManager! Task : " << task->name() );
 
 		////////////////////////////////////
 
 		// add in active list
-		m_activeTaskList.push_back( task );
-		m_activeListChanged = true; // we'll need to update the execution list before the next tasks execution
+		insertInList( m_activeTaskList, task, &Task::m_stateListIndex );
+		scheduleExecution( task ); // will be merged in the execution list before the next tasks execution
 
 		// change task state
 		task->m_state = TS_ACTIVE;
@@ -136,13 +217,24 @@ namespace gcore
 		GC_ASSERT( task->m_state == TS_ACTIVE , "Tried to deactivate an unactive task!" );
 		GC_ASSERT( task->m_taskManager == this , "Tried to deactivate a task not registered in this task manager!" );
 
-		// remove from active tasks list - this one can be expensive? have to check
-		m_activeTaskList.remove( task );
+		// remove from active tasks list
+		removeFromList( m_activeTaskList, task, &Task::m_stateListIndex );
 
 		// remove from the current execution list 
 		// note : to do this we only set the task to null in the execution list
 		// to manage the case where this method is called in the task execution loop
-		std::replace( m_executionTaskList.begin(), m_executionTaskList.end(), task, static_cast< Task* >( nullptr ) );
+		if( task->m_executionIndex < m_executionTaskList.size() && m_executionTaskList[ task->m_executionIndex ] == task )
+		{
+			m_executionTaskList[ task->m_executionIndex ] = nullptr;
+			++m_removedExecutionTaskCount;
+		}
+		task->m_executionIndex = INVALID_INDEX;
+
+		// not activated yet : forget it
+		if( task->m_pendingExecutionIndex != INVALID_INDEX )
+		{
+			removeFromList( m_pendingExecutionTasks, task, &Task::m_pendingExecutionIndex );
+		}
 		
 		// we'll need to update the execution list before the next tasks execution
 		m_activeListChanged = true;
@@ -153,6 +245,7 @@ namespace gcore
 	{
 		// task not null
 		GC_ASSERT( task != nullptr , "Tried to terminate a null task!" );
+		StateLock lock( m_stateMutex );
 		
 		// task must be registered
 		if( task->m_state == TS_UNREGISTERED )
@@ -166,7 +259,7 @@ namespace gcore
 			GC_EXCEPTION << "Tried to terminate a task not registered in this TaskManager! Task : " << task->name() ;
 		}
 		
-		GC_ASSERT( std::find( m_registeredTasksList.begin(), m_registeredTasksList.end(), task) != m_registeredTasksList.end() , "Tried to activate task not registered in this TaskManager! Task : " << task->name() )
+		GC_ASSERT( isRegisteredHere( task ) , "Tried to activate task not registered in this TaskManager! Task : " << task->name() );
 		/////////////////////////////
 		
 
@@ -182,7 +275,7 @@ namespace gcore
 		case( TS_PAUSED ):
 			{
 				// remove from paused tasks list
-				m_pausedTasksList.remove( task );
+				removeFromList( m_pausedTasksList, task, &Task::m_stateListIndex );
 				break;
 			}
 		default:
@@ -203,6 +296,7 @@ namespace gcore
 	{
 		// task not null
 		GC_ASSERT( task != nullptr , "Tried to pause a null task!" );
+		StateLock lock( m_stateMutex );
 
 		// task registered here
 		if( task->m_taskManager != this )
@@ -216,13 +310,13 @@ namespace gcore
 			GC_EXCEPTION << "Tried to pause a non active task! Task : " << task->name() ;
 		}
 		
-		GC_ASSERT( std::find( m_registeredTasksList.begin(), m_registeredTasksList.end(), task) != m_registeredTasksList.end() , "Tried to activate task not registered in this TaskManager! Task : " << task->name() )
+		GC_ASSERT( isRegisteredHere( task ) , "Tried to activate task not registered in this TaskManager! Task : " << task->name() );
 		/////////////////////////////
 		// deactivate the task
 		deactivateTask( task );
 
 		// add task in paused list
-		m_pausedTasksList.push_back( task );
+		insertInList( m_pausedTasksList, task, &Task::m_stateListIndex );
 
 		// change state
 		task->m_state = TS_PAUSED;
@@ -236,6 +330,7 @@ namespace gcore
 	{
 		// task not null
 		GC_ASSERT( task != nullptr , "Tried to resume a null task!" );
+		StateLock lock( m_stateMutex );
 
 		// task registered here
 		if( task->m_taskManager != this )
@@ -249,14 +344,14 @@ namespace gcore
 			GC_EXCEPTION << "Tried to resume a non paused task! Task : " << task->name() ;
 		}
 
-		GC_ASSERT( std::find( m_registeredTasksList.begin(), m_registeredTasksList.end(), task) != m_registeredTasksList.end() , "Tried to activate task not registered in this TaskManager! Task : " << task->name() );
+		GC_ASSERT( isRegisteredHere( task ) , "Tried to activate task not registered in this TaskManager! Task : " << task->name() );
 		//////////////////////////////
 		// remove from paused tasks list
-		m_pausedTasksList.remove( task );
+		removeFromList( m_pausedTasksList, task, &Task::m_stateListIndex );
 
 		// insert task in active list
-		m_activeTaskList.push_back(task);
-		m_activeListChanged = true;	// we'll need to update the execution list before the next tasks execution
+		insertInList( m_activeTaskList, task, &Task::m_stateListIndex );
+		scheduleExecution( task ); // will be merged in the execution list before the next tasks execution
 		
 		//change state
 		task->m_state = TS_ACTIVE;
@@ -271,8 +366,9 @@ namespace gcore
 	{
 		//task not null
 		GC_ASSERT( task != nullptr , "Tried to change the priority of a null task!" );
+		StateLock lock( m_stateMutex );
 		GC_ASSERT( task->m_taskManager == this , "Tried to change the priority of a task not registered in this task manager!" );
-		GC_ASSERT( std::find( m_registeredTasksList.begin(), m_registeredTasksList.end(), task) != m_registeredTasksList.end() , "Tried to activate task not registered in this TaskManager! Task : " << task->name() );
+		GC_ASSERT( isRegisteredHere( task ) , "Tried to activate task not registered in this TaskManager! Task : " << task->name() );
 		// if current priority is the same, don"t change anything
 		if( task->m_priority == newPriority ) return;
 		
@@ -283,8 +379,9 @@ namespace gcore
 		//if task is in active list
 		if( task->m_state ==  TS_ACTIVE)
 		{
-			// we'll need to update the execution list before the next tasks execution
-			m_activeListChanged = true;
+			// move it at it's new place in the execution list on next update
+			// note : it stays in the current execution list until then
+			scheduleExecution( task );
 		}
 
 	}
@@ -292,15 +389,66 @@ namespace gcore
 
 	Task* TaskManager::getRegisteredTask(const String& name) const
 	{
+		StateLock lock( m_stateMutex );
 		TaskIndex::const_iterator findIt = m_namedTasksIndex.find(name);
 
 		if( findIt == m_namedTasksIndex.end() ) return nullptr; //Not found
 		else return (findIt->second);	// found!
 	}
 
+	inline void TaskManager::executeTask( Task* task )
+	{
+		// keep the non profiled execution as cheap as possible
+		if( task->m_profile == nullptr ) task->onExecute();
+		else executeProfiledTask( task );
+	}
+
+	void TaskManager::executeProfiledTask( Task* task )
+	{
+		// the execution can disable profiling, unregister or delete the task : 
+		// the profile is then kept until the end of executeTasks
+		const TimeReferenceProvider* timeReference = m_profilingTimeReference;
+		TaskProfile* profile = task->m_profile;
+
+		// ticks keep the precision of short executions
+		const TimeTicks startTicks = timeReference->getTicksSinceStart();
+		task->onExecute();
+		profile->record( timeReference->ticksToTime( timeReference->getTicksSinceStart() - startTicks ) );
+	}
+
+	void TaskManager::destroyProfile( TaskProfile* profile )
+	{
+		if( m_isExecutingTasks ) m_retiredProfiles.push_back( std::make_pair( m_taskProfilePool, profile ) );
+		else m_taskProfilePool->destroy( profile );
+	}
+
+	void TaskManager::destroyRetiredProfiles()
+	{
+		if( m_retiredProfiles.empty() && m_retiredProfilePools.empty() ) return; // be lazy!
+
+		StateLock lock( m_stateMutex );
+
+		// profiles first : their pool could be retired too
+		for( std::size_t i = 0; i < m_retiredProfiles.size(); ++i )
+		{
+			m_retiredProfiles[i].first->destroy( m_retiredProfiles[i].second );
+		}
+		m_retiredProfiles.clear();
+
+		for( std::size_t i = 0; i < m_retiredProfilePools.size(); ++i )
+		{
+			delete m_retiredProfilePools[i];
+		}
+		m_retiredProfilePools.clear();
+	}
+
 	void TaskManager::executeTasks()
 	{
 		if( m_activeTaskList.empty() ) return ; // be lazy!
+
+		const TimeReferenceProvider* timeReference = m_profilingTimeReference;
+		const TimeTicks startTicks = timeReference != nullptr ? timeReference->getTicksSinceStart() : 0;
+		const TimeValue deadlineStartTime = m_deadlineTimeReference != nullptr ? m_deadlineTimeReference->getTimeSinceStart() : 0;
 		
 		/*
 			To prevent all the issues from modifying the active tasks lists,
@@ -315,54 +463,618 @@ namespace gcore
 		*/
 
 		// Update execution list if active list have been modified since last update.
-		if( m_activeListChanged )
+		updateExecutionList();
+
+		// profiles removed by the tasks are destroyed once they are all executed
+		m_isExecutingTasks = true;
+		try
+		{
+			if( m_executionMode == TEM_PARALLEL_STAGES )
+			{
+				executeStages();
+			}
+			else if( m_executionMode == TEM_DEPENDENCY_GRAPH )
+			{
+				executeGraph();
+			}
+			else if( m_deadlineTimeReference != nullptr )
+			{
+				executeUntilDeadline( deadlineStartTime );
+			}
+			else
+			{
+				// Execute the tasks
+				for( std::vector< Task* >::iterator taskCursor = m_executionTaskList.begin(); taskCursor != m_executionTaskList.end() ; ++taskCursor )
+				{
+					Task* task = (*taskCursor);
+
+					if( task != nullptr ) // ignore removed tasks
+					{
+						GC_ASSERT( task->m_state == TS_ACTIVE, String( "Found an non active task in execution list! Task :" ) + task->name() );
+						GC_ASSERT( task->m_taskManager == this, "Found an active task in execution list that is not managed here! Task :" << task->name() );
+						executeTask( task );
+					}
+
+				}
+			}
+		}
+		catch( ... )
+		{
+			m_isExecutingTasks = false;
+			destroyRetiredProfiles();
+			throw;
+		}
+		m_isExecutingTasks = false;
+		destroyRetiredProfiles();
+
+		// profiling might have been enabled or disabled by a task
+		if( timeReference != nullptr && timeReference == m_profilingTimeReference )
+		{
+			m_frameProfile.record( timeReference->ticksToTime( timeReference->getTicksSinceStart() - startTicks ) );
+		}
+
+	}
+
+	void TaskManager::updateExecutionList()
+	{
+		StateLock lock( m_stateMutex );
+
+		if( !m_activeListChanged ) return;
+
+		// remember the first task deferred on last execution to start with it next time
+		Task* firstDeferredTask = nullptr;
+		for( std::size_t i = m_firstDeferredIndex; i < m_executionTaskList.size() && firstDeferredTask == nullptr; ++i )
+		{
+			firstDeferredTask = m_executionTaskList[i];
+		}
+
+		// as active task has changed, re register the execution task list as necessary :
+		if( m_dependencyCount > 0 || !m_executionListSorted )
+		{
+			// dependencies between active tasks can change the order : rebuild and sort all
+			for( TaskList::iterator it = m_pendingExecutionTasks.begin(); it != m_pendingExecutionTasks.end(); ++it )
+			{
+				(*it)->m_pendingExecutionIndex = INVALID_INDEX;
+			}
+			m_pendingExecutionTasks.clear();
+
+			m_executionTaskList.assign( m_activeTaskList.begin(), m_activeTaskList.end() );
+			std::sort( m_executionTaskList.begin(), m_executionTaskList.end(), TaskCompare_AscendingPriority() );
+		}
+		else
+		{
+			// only merge the new active tasks in the already sorted execution list
+			mergeExecutionList();
+		}
+		m_removedExecutionTaskCount = 0;
+		GC_ASSERT( m_executionTaskList.size() == m_activeTaskList.size(), "Invalid state : execution task list is not the same size than the active task list!?" );
+
+		const std::size_t taskCount = m_executionTaskList.size();
+		for( std::size_t i = 0; i < taskCount; ++i )
+		{
+			m_executionTaskList[i]->m_executionIndex = i;
+		}
+
+		if( m_dependencyCount > 0 )
+		{
+			sortExecutionDependencies();
+			m_executionListSorted = false;
+		}
+		else
+		{
+			m_graphSuccessors.clear();
+			m_graphSuccessorsBegin.assign( taskCount + 1, 0 );
+			m_graphDependencyCount.assign( taskCount, 0 );
+			m_executionListSorted = true;
+		}
+
+		// the deferrable tasks are at the end of the list if sorted only by priority
+		if( m_executionListSorted )
+		{
+			m_firstDeferrableIndex = 0;
+			while( m_firstDeferrableIndex < taskCount && m_executionTaskList[ m_firstDeferrableIndex ]->priority() < m_deferrablePriority )
+			{
+				++m_firstDeferrableIndex;
+			}
+		}
+		else
 		{
-			// as active task has changed, re register the execution task list as necessary :
-			m_activeTaskList.sort( TaskCompare_AscendingPriority() ); // sort first
-			
-			// update the execution list
-			m_executionTaskList = std::vector< Task* >( m_activeTaskList.begin(), m_activeTaskList.end() );
-			GC_ASSERT( !m_executionTaskList.empty(), "Invalid state : execution task list is empty while active task list is not!?" );
+			m_firstDeferrableIndex = taskCount;
+		}
 
-			m_activeListChanged = false;
+		// a task a non deferrable task depends on can't be deferred : the successors are after their dependencies
+		m_deferrableTasks.resize( taskCount );
+		for( std::size_t i = taskCount; i-- > 0; )
+		{
+			bool isDeferrable = m_executionTaskList[i]->priority() >= m_deferrablePriority;
+			for( std::size_t k = m_graphSuccessorsBegin[i]; k < m_graphSuccessorsBegin[ i + 1 ] && isDeferrable; ++k )
+			{
+				isDeferrable = m_deferrableTasks[ m_graphSuccessors[k] ];
+			}
+			m_deferrableTasks[i] = isDeferrable;
 		}
 
-		// Execute the tasks
-		for( std::vector< Task* >::iterator taskCursor = m_executionTaskList.begin(); taskCursor != m_executionTaskList.end() ; ++taskCursor )
+		m_firstDeferredIndex = INVALID_INDEX;
+		if( firstDeferredTask != nullptr && firstDeferredTask->m_executionIndex >= m_firstDeferrableIndex && firstDeferredTask->m_executionIndex < taskCount )
 		{
-			Task* task = (*taskCursor);
+			m_firstDeferredIndex = firstDeferredTask->m_executionIndex;
+		}
 
-			if( task != nullptr ) // ignore removed tasks
+		// update the stages : one by priority value, and a task can't be in the same stage than one of it's dependencies
+		m_executionStages.clear();
+		std::size_t stageBegin = 0;
+		for( std::size_t i = 0; i < taskCount; ++i )
+		{
+			Task* task = m_executionTaskList[i];
+			bool isNewStage = ( i == 0 || task->priority() != m_executionTaskList[ i - 1 ]->priority() );
+
+			if( !isNewStage && m_graphDependencyCount[i] > 0 )
 			{
-				GC_ASSERT( task->m_state == TS_ACTIVE, String( "Found an non active task in execution list! Task :" ) + task->name() );
-				GC_ASSERT( task->m_taskManager == this, "Found an active task in execution list that is not managed here! Task :" << task->name() );
-				task->onExecute();
+				for( std::vector< Task* >::const_iterator it = task->m_dependencies.begin(); it != task->m_dependencies.end(); ++it )
+				{
+					if( (*it)->m_state == TS_ACTIVE && (*it)->m_executionIndex >= stageBegin )
+					{
+						isNewStage = true;
+						break;
+					}
+				}
 			}
 
+			if( isNewStage )
+			{
+				m_executionStages.push_back( i );
+				stageBegin = i;
+			}
+		}
+		m_executionStages.push_back( taskCount );
+
+		m_activeListChanged = false;
+	}
+
+	void TaskManager::mergeExecutionList()
+	{
+		// remove the removed tasks and the tasks that will be inserted again
+		if( m_removedExecutionTaskCount > 0 || !m_pendingExecutionTasks.empty() )
+		{
+			std::vector< Task* >::iterator outputIt = m_executionTaskList.begin();
+			for( std::vector< Task* >::iterator it = m_executionTaskList.begin(); it != m_executionTaskList.end(); ++it )
+			{
+				Task* task = *it;
+				if( task != nullptr && task->m_pendingExecutionIndex == INVALID_INDEX )
+				{
+					*outputIt = task;
+					++outputIt;
+				}
+			}
+			m_executionTaskList.erase( outputIt, m_executionTaskList.end() );
 		}
 
+		if( m_pendingExecutionTasks.empty() ) return;
+
+		// sort the new tasks only, then merge them with the others
+		std::sort( m_pendingExecutionTasks.begin(), m_pendingExecutionTasks.end(), TaskCompare_AscendingPriority() );
+
+		std::vector< Task* > mergedTasks;
+		mergedTasks.reserve( m_executionTaskList.size() + m_pendingExecutionTasks.size() );
+		std::merge( m_executionTaskList.begin(), m_executionTaskList.end()
+			, m_pendingExecutionTasks.begin(), m_pendingExecutionTasks.end()
+			, std::back_inserter( mergedTasks ), TaskCompare_AscendingPriority() );
+		m_executionTaskList.swap( mergedTasks );
+
+		for( TaskList::iterator it = m_pendingExecutionTasks.begin(); it != m_pendingExecutionTasks.end(); ++it )
+		{
+			(*it)->m_pendingExecutionIndex = INVALID_INDEX;
+		}
+		m_pendingExecutionTasks.clear();
+	}
+
+	void TaskManager::executeUntilDeadline( TimeValue frameStartTime )
+	{
+		const std::size_t taskCount = m_executionTaskList.size();
+		bool isDeadlineReached = false;
+		m_deferredTaskCount = 0;
+
+		// first the tasks that have to be executed each time, in order
+		// note : if the list is sorted by dependencies, the deferrable tasks are here too
+		for( std::size_t i = 0; i < m_firstDeferrableIndex; ++i )
+		{
+			Task* task = m_executionTaskList[i];
+			if( task == nullptr ) continue; // ignore removed tasks
+
+			if( m_deferrableTasks[i] )
+			{
+				isDeadlineReached = isDeadlineReached || m_deadlineTimeReference->getTimeSinceStart() - frameStartTime >= m_frameBudget;
+				if( isDeadlineReached )
+				{
+					deferTask( task );
+					continue;
+				}
+				task->m_consecutiveDeferralCount = 0;
+			}
+
+			executeTask( task );
+		}
+
+		// then the deferrable tasks until the deadline, starting with the ones deferred last time
+		const std::size_t deferrableCount = taskCount - m_firstDeferrableIndex;
+		const std::size_t firstIndex = m_firstDeferredIndex != INVALID_INDEX ? m_firstDeferredIndex - m_firstDeferrableIndex : 0;
+		m_firstDeferredIndex = INVALID_INDEX;
+
+		for( std::size_t k = 0; k < deferrableCount; ++k )
+		{
+			const std::size_t index = m_firstDeferrableIndex + ( firstIndex + k ) % deferrableCount;
+			Task* task = m_executionTaskList[ index ];
+			if( task == nullptr ) continue; // ignore removed tasks
+
+			isDeadlineReached = isDeadlineReached || m_deadlineTimeReference->getTimeSinceStart() - frameStartTime >= m_frameBudget;
+			if( isDeadlineReached )
+			{
+				if( m_firstDeferredIndex == INVALID_INDEX ) m_firstDeferredIndex = index;
+				deferTask( task );
+				continue;
+			}
+
+			task->m_consecutiveDeferralCount = 0;
+			executeTask( task );
+		}
+	}
+
+	void TaskManager::deferTask( Task* task )
+	{
+		++task->m_deferralCount;
+		++task->m_consecutiveDeferralCount;
+		++m_deferredTaskCount;
+	}
+
+	void TaskManager::executeTaskAt( std::size_t index )
+	{
+		Task* task = nullptr;
+
+		{
+			// the task might be paused or terminated by another task being executed
+			StateLock lock( m_stateMutex );
+			if( index < m_executionTaskList.size() ) task = m_executionTaskList[ index ];
+		}
+
+		if( task != nullptr ) // ignore removed tasks
+		{
+			GC_ASSERT( task->m_taskManager == this, "Found an active task in execution list that is not managed here! Task :" << task->name() );
+			executeTask( task );
+		}
+	}
+
+	void TaskManager::executeStages()
+	{
+		GC_ASSERT_NOT_NULL( m_workerPool );
+
+		const std::size_t stageCount = m_executionStages.size() - 1;
+		for( std::size_t stage = 0; stage < stageCount; ++stage )
+		{
+			const std::size_t stageBegin = m_executionStages[ stage ];
+			const std::size_t stageEnd = m_executionStages[ stage + 1 ];
+
+			try
+			{
+				// let the workers execute all the tasks of the stage but the first one...
+				for( std::size_t i = stageBegin + 1; i < stageEnd; ++i )
+				{
+					m_workerPool->push( std::tr1::bind( &TaskManager::executeTaskAt, this, i ) );
+				}
+
+				// ... that we execute ourself before helping the workers
+				executeTaskAt( stageBegin );
+			}
+			catch( ... )
+			{
+				// the jobs already pushed use the execution list : let them finish
+				try { m_workerPool->wait(); }
+				catch( ... ) { ; } // the first failure is reported
+				throw;
+			}
+
+			if( stageEnd - stageBegin > 1 )
+			{
+				m_workerPool->wait();
+			}
+		}
+	}
+
+	void TaskManager::sortExecutionDependencies()
+	{
+		const std::size_t taskCount = m_executionTaskList.size();
+
+		// count the active dependencies of each task
+		std::vector< unsigned int > remainingDependencies( taskCount, 0 );
+		for( std::size_t i = 0; i < taskCount; ++i )
+		{
+			const std::vector< Task* >& dependencies = m_executionTaskList[i]->m_dependencies;
+			for( std::vector< Task* >::const_iterator it = dependencies.begin(); it != dependencies.end(); ++it )
+			{
+				if( (*it)->m_state == TS_ACTIVE ) ++remainingDependencies[i];
+			}
+		}
+
+		// topological sort : the ready task with the lowest index (so priority) goes first
+		std::priority_queue< std::size_t, std::vector< std::size_t >, std::greater< std::size_t > > readyTasks;
+		for( std::size_t i = 0; i < taskCount; ++i )
+		{
+			if( remainingDependencies[i] == 0 ) readyTasks.push( i );
+		}
+
+		std::vector< Task* > sortedTasks;
+		sortedTasks.reserve( taskCount );
+		while( !readyTasks.empty() )
+		{
+			Task* task = m_executionTaskList[ readyTasks.top() ];
+			readyTasks.pop();
+			sortedTasks.push_back( task );
+
+			for( std::vector< Task* >::const_iterator it = task->m_dependentTasks.begin(); it != task->m_dependentTasks.end(); ++it )
+			{
+				Task* dependentTask = *it;
+				if( dependentTask->m_state == TS_ACTIVE && --remainingDependencies[ dependentTask->m_executionIndex ] == 0 )
+				{
+					readyTasks.push( dependentTask->m_executionIndex );
+				}
+			}
+		}
+
+		GC_ASSERT( sortedTasks.size() == taskCount, "Found a cycle in the task dependencies!" );
+		m_executionTaskList.swap( sortedTasks );
+
+		// now build the dependency graph in the execution order
+		m_graphDependencyCount.assign( taskCount, 0 );
+		m_graphSuccessors.clear();
+		m_graphSuccessorsBegin.resize( taskCount + 1 );
+
+		for( std::size_t i = 0; i < taskCount; ++i )
+		{
+			m_executionTaskList[i]->m_executionIndex = i;
+		}
+
+		for( std::size_t i = 0; i < taskCount; ++i )
+		{
+			Task* task = m_executionTaskList[i];
+			m_graphSuccessorsBegin[i] = m_graphSuccessors.size();
+
+			for( std::vector< Task* >::const_iterator it = task->m_dependentTasks.begin(); it != task->m_dependentTasks.end(); ++it )
+			{
+				Task* dependentTask = *it;
+				if( dependentTask->m_state == TS_ACTIVE )
+				{
+					m_graphSuccessors.push_back( dependentTask->m_executionIndex );
+					++m_graphDependencyCount[ dependentTask->m_executionIndex ];
+				}
+			}
+		}
+		m_graphSuccessorsBegin[ taskCount ] = m_graphSuccessors.size();
+	}
+
+	void TaskManager::executeGraph()
+	{
+		GC_ASSERT_NOT_NULL( m_workerPool );
+
+		const std::size_t taskCount = m_executionTaskList.size();
+
+		if( m_graphPendingDependenciesSize < taskCount )
+		{
+			m_graphPendingDependencies.reset( new boost::atomic< unsigned int >[ taskCount ] );
+			m_graphPendingDependenciesSize = taskCount;
+		}
+
+		for( std::size_t i = 0; i < taskCount; ++i )
+		{
+			m_graphPendingDependencies[i] = m_graphDependencyCount[i];
+		}
+
+		// start with the tasks without dependency, the others will follow once ready
+		try
+		{
+			for( std::size_t i = 0; i < taskCount; ++i )
+			{
+				if( m_graphDependencyCount[i] == 0 )
+				{
+					m_workerPool->push( std::tr1::bind( &TaskManager::executeGraphNode, this, i ) );
+				}
+			}
+		}
+		catch( ... )
+		{
+			// the jobs already pushed use the execution list : let them finish
+			try { m_workerPool->wait(); }
+			catch( ... ) { ; } // the first failure is reported
+			throw;
+		}
+
+		m_workerPool->wait();
+	}
+
+	void TaskManager::executeGraphNode( std::size_t index )
+	{
+		// note : if the task throws, the dependent tasks will not be executed this cycle
+		executeTaskAt( index );
+
+		// schedule the dependent tasks that have no more dependency to wait for
+		const std::size_t successorsEnd = m_graphSuccessorsBegin[ index + 1 ];
+		for( std::size_t i = m_graphSuccessorsBegin[ index ]; i < successorsEnd; ++i )
+		{
+			const std::size_t successor = m_graphSuccessors[i];
+			if( --m_graphPendingDependencies[ successor ] == 0 )
+			{
+				m_workerPool->push( std::tr1::bind( &TaskManager::executeGraphNode, this, successor ) );
+			}
+		}
+	}
+
+	void TaskManager::addTaskDependency( Task* task, Task* dependency )
+	{
+		GC_ASSERT( task != nullptr , "Tried to add a dependency to a null task!" );
+		GC_ASSERT( dependency != nullptr , "Tried to add a null task as dependency!" );
+
+		StateLock lock( m_stateMutex );
+
+		if( task->m_taskManager != this || dependency->m_taskManager != this )
+		{
+			GC_EXCEPTION << "Tried to add a dependency between tasks not registered in this TaskManager! Task : " << task->name() << " Dependency : " << dependency->name();
+		}
+
+		if( task == dependency )
+		{
+			GC_EXCEPTION << "Tried to make a task depend on itself! Task : " << task->name();
+		}
+
+		if( std::find( task->m_dependencies.begin(), task->m_dependencies.end(), dependency ) != task->m_dependencies.end() )
+		{
+			GC_EXCEPTION << "Tried to add a task dependency twice! Task : " << task->name() << " Dependency : " << dependency->name();
+		}
+
+		// check now that we don't create a cycle, it would be too late on execution
+		if( isDependentOn( dependency, task ) )
+		{
+			GC_EXCEPTION << "Tried to add a cyclic task dependency! Task : " << task->name() << " Dependency : " << dependency->name();
+		}
+
+		//////////////////////////
+		task->m_dependencies.push_back( dependency );
+		dependency->m_dependentTasks.push_back( task );
+		++m_dependencyCount;
+
+		if( task->m_state == TS_ACTIVE && dependency->m_state == TS_ACTIVE )
+		{
+			// we'll need to update the execution list before the next tasks execution
+			m_activeListChanged = true;
+		}
+	}
+
+	void TaskManager::removeTaskDependency( Task* task, Task* dependency )
+	{
+		GC_ASSERT( task != nullptr , "Tried to remove a dependency from a null task!" );
+		GC_ASSERT( dependency != nullptr , "Tried to remove a null task dependency!" );
+
+		StateLock lock( m_stateMutex );
+
+		std::vector< Task* >::iterator dependencyIt = std::find( task->m_dependencies.begin(), task->m_dependencies.end(), dependency );
+		if( dependencyIt == task->m_dependencies.end() )
+		{
+			GC_EXCEPTION << "Tried to remove a task dependency that was not added! Task : " << task->name() << " Dependency : " << dependency->name();
+		}
+
+		task->m_dependencies.erase( dependencyIt );
+		dependency->m_dependentTasks.erase( std::find( dependency->m_dependentTasks.begin(), dependency->m_dependentTasks.end(), task ) );
+		--m_dependencyCount;
+
+		if( task->m_state == TS_ACTIVE && dependency->m_state == TS_ACTIVE )
+		{
+			m_activeListChanged = true;
+		}
+	}
+
+	void TaskManager::removeAllTaskDependencies( Task* task )
+	{
+		GC_ASSERT( task != nullptr , "Tried to remove the dependencies of a null task!" );
+
+		StateLock lock( m_stateMutex );
+
+		if( task->m_dependencies.empty() && task->m_dependentTasks.empty() ) return; // be lazy!
+
+		for( std::vector< Task* >::iterator it = task->m_dependencies.begin(); it != task->m_dependencies.end(); ++it )
+		{
+			std::vector< Task* >& dependentTasks = (*it)->m_dependentTasks;
+			dependentTasks.erase( std::remove( dependentTasks.begin(), dependentTasks.end(), task ), dependentTasks.end() );
+		}
+
+		for( std::vector< Task* >::iterator it = task->m_dependentTasks.begin(); it != task->m_dependentTasks.end(); ++it )
+		{
+			std::vector< Task* >& dependencies = (*it)->m_dependencies;
+			dependencies.erase( std::remove( dependencies.begin(), dependencies.end(), task ), dependencies.end() );
+		}
+
+		m_dependencyCount -= task->m_dependencies.size() + task->m_dependentTasks.size();
+		task->m_dependencies.clear();
+		task->m_dependentTasks.clear();
+
+		if( task->m_state == TS_ACTIVE ) m_activeListChanged = true;
+	}
+
+	bool TaskManager::isDependentOn( Task* task, Task* dependency ) const
+	{
+		// depth-first search through the dependencies of the task
+		std::vector< Task* > tasksToVisit( task->m_dependencies.begin(), task->m_dependencies.end() );
+		std::set< Task* > visitedTasks;
+
+		while( !tasksToVisit.empty() )
+		{
+			Task* visitedTask = tasksToVisit.back();
+			tasksToVisit.pop_back();
+
+			if( visitedTask == dependency ) return true;
+			if( !visitedTasks.insert( visitedTask ).second ) continue; // already visited
+
+			tasksToVisit.insert( tasksToVisit.end(), visitedTask->m_dependencies.begin(), visitedTask->m_dependencies.end() );
+		}
+
+		return false;
+	}
+
+	void TaskManager::setFrameDeadline( const TimeReferenceProvider& timeReference, TimeValue frameBudget, TaskPriority deferrablePriority )
+	{
+		StateLock lock( m_stateMutex );
+
+		m_deadlineTimeReference = &timeReference;
+		m_frameBudget = frameBudget;
+
+		if( m_deferrablePriority != deferrablePriority )
+		{
+			m_deferrablePriority = deferrablePriority;
+			m_activeListChanged = true; // the deferrable tasks have to be found again
+		}
+	}
+
+	void TaskManager::removeFrameDeadline()
+	{
+		StateLock lock( m_stateMutex );
+		m_deadlineTimeReference = nullptr;
+		m_deferredTaskCount = 0;
+	}
+
+	void TaskManager::setExecutionMode( TaskExecutionMode mode, WorkerPool* workerPool )
+	{
+		if( mode != TEM_SEQUENTIAL && workerPool == nullptr )
+		{
+			GC_EXCEPTION << "Tried to set a parallel task execution mode without WorkerPool!";
+		}
+
+		StateLock lock( m_stateMutex );
+		m_executionMode = mode;
+		m_workerPool = workerPool;
 	}
 
 	void TaskManager::terminateAllTasks()
 	{
+		StateLock lock( m_stateMutex );
+
 		// terminate active & paused tasks :
 		// gather the tasks
-		std::list<Task*> tasksToTerminate( m_activeTaskList.begin(), m_activeTaskList.end() );
+		TaskList tasksToTerminate( m_activeTaskList.begin(), m_activeTaskList.end() );
 		tasksToTerminate.insert( tasksToTerminate.end(), m_pausedTasksList.begin(), m_pausedTasksList.end() );
 
 		// clear active tasks list
 		m_activeTaskList.clear();
 		m_pausedTasksList.clear();
+		m_pendingExecutionTasks.clear();
 
 		// terminate tasks 
-		for(std::list<Task*>::iterator itTask = tasksToTerminate.begin(); itTask != tasksToTerminate.end() ; ++itTask)
+		for( TaskList::iterator itTask = tasksToTerminate.begin(); itTask != tasksToTerminate.end() ; ++itTask )
 		{
 			Task* task = (*itTask);
 
 			GC_ASSERT( task != nullptr , "Found a null task in the task manager!" );
-			GC_ASSERT( std::find( m_registeredTasksList.begin(), m_registeredTasksList.end(), task) != m_registeredTasksList.end() , "Tried to activate task not registered in this TaskManager! Task : " << task->name() )
+			GC_ASSERT( isRegisteredHere( task ) , "Tried to activate task not registered in this TaskManager! Task : " << task->name() );
 			//change state
 			task->m_state = TS_REGISTERED;
+			task->m_stateListIndex = INVALID_INDEX;
+			task->m_executionIndex = INVALID_INDEX;
+			task->m_pendingExecutionIndex = INVALID_INDEX;
 			//user defined termination
 			task->onTerminate();
 		}
@@ -372,6 +1084,11 @@ namespace gcore
 
 		// clear execution list
 		m_executionTaskList.clear();
+		m_deferrableTasks.clear();
+		m_firstDeferrableIndex = 0;
+		m_firstDeferredIndex = INVALID_INDEX;
+		m_removedExecutionTaskCount = 0;
+		m_executionListSorted = true;
 		m_activeListChanged = false;
 
 	}
@@ -379,6 +1096,8 @@ namespace gcore
 
 	void TaskManager::unregisterAllTasks()
 	{
+		StateLock lock( m_stateMutex );
+
 		// first, clear all lists if necessary
 		terminateAllTasks();
 
@@ -388,13 +1107,131 @@ namespace gcore
 			Task* task = (*it);
 
 			GC_ASSERT( task != nullptr , "Found a null task in the task manager!" );
-			GC_ASSERT( std::find( m_registeredTasksList.begin(), m_registeredTasksList.end(), task) != m_registeredTasksList.end() , "Tried to activate task not registered in this TaskManager! Task : " << task->name() )
+			GC_ASSERT( isRegisteredHere( task ) , "Tried to activate task not registered in this TaskManager! Task : " << task->name() );
 			task->m_state = TS_UNREGISTERED;
 			task->m_taskManager = nullptr;
+			task->m_registeredIndex = INVALID_INDEX;
+			task->m_profile = nullptr;
+			task->m_dependencies.clear();
+			task->m_dependentTasks.clear();
 		}
 
 		// then unregister them all from here
 		m_registeredTasksList.clear();
+		m_dependencyCount = 0;
+
+		// the task profiles are not used anymore
+		if( m_isExecutingTasks ) m_retiredProfilePools.push_back( m_taskProfilePool ); // a task being executed could still use it's profile
+		else delete m_taskProfilePool;
+		m_taskProfilePool = new TaskProfilePool();
+	}
+
+	void TaskManager::enableTaskProfiling( const TimeReferenceProvider& timeReference )
+	{
+		StateLock lock( m_stateMutex );
+
+		if( !isTaskProfilingEnabled() )
+		{
+			for( TaskList::iterator it = m_registeredTasksList.begin(); it != m_registeredTasksList.end(); ++it )
+			{
+				(*it)->m_profile = m_taskProfilePool->construct();
+			}
+			m_frameProfile.clear();
+		}
+
+		m_profilingTimeReference = &timeReference;
+	}
+
+	void TaskManager::disableTaskProfiling()
+	{
+		StateLock lock( m_stateMutex );
+
+		if( !isTaskProfilingEnabled() ) return;
+
+		for( TaskList::iterator it = m_registeredTasksList.begin(); it != m_registeredTasksList.end(); ++it )
+		{
+			destroyProfile( (*it)->m_profile );
+			(*it)->m_profile = nullptr;
+		}
+
+		m_profilingTimeReference = nullptr;
+	}
+
+	const TaskProfile* TaskManager::taskProfile( const Task* task ) const
+	{
+		GC_ASSERT( task != nullptr , "Tried to get the profile of a null task!" );
+		GC_ASSERT( task->m_taskManager == this , "Tried to get the profile of a task not registered in this task manager!" );
+		return task->m_profile;
+	}
+
+	void TaskManager::clearTaskProfiles()
+	{
+		StateLock lock( m_stateMutex );
+
+		for( TaskList::iterator it = m_registeredTasksList.begin(); it != m_registeredTasksList.end(); ++it )
+		{
+			if( (*it)->m_profile != nullptr ) (*it)->m_profile->clear();
+		}
+		m_frameProfile.clear();
+	}
+
+	void TaskManager::reportTaskProfiles( std::ostream& outputStream, TimeValue frameBudget ) const
+	{
+		StateLock lock( m_stateMutex );
+
+		if( !isTaskProfilingEnabled() )
+		{
+			outputStream << "\nTask profiling is not enabled." << '\n';
+			return;
+		}
+
+		// gather the executed tasks, the most expensive first
+		typedef std::pair< TimeValue, const Task* > TaskAverageTime;
+		std::vector< TaskAverageTime > profiledTasks;
+		for( TaskList::const_iterator it = m_registeredTasksList.begin(); it != m_registeredTasksList.end(); ++it )
+		{
+			const TaskProfile* profile = (*it)->m_profile;
+			if( profile->executionCount() > 0 ) profiledTasks.push_back( TaskAverageTime( profile->average(), *it ) );
+		}
+		std::sort( profiledTasks.begin(), profiledTasks.end(), std::greater< TaskAverageTime >() );
+
+		outputStream << "\nTasks execution times over the last " << m_frameProfile.sampleCount() << " frames : " << '\n';
+		outputStream << "\tFrame : \taverage " << m_frameProfile.average() << "\tp99 " << m_frameProfile.percentile99()
+			<< "\tshortest " << m_frameProfile.shortest() << "\tbiggest " << m_frameProfile.biggest() << '\n';
+
+		if( frameBudget > 0 )
+		{
+			outputStream << "\tBudget : \t" << frameBudget << "\tused in average : " << ( 100 * m_frameProfile.average() / frameBudget ) << "%"
+				<< "\tframes over budget : " << m_frameProfile.countOver( frameBudget ) << '\n';
+		}
+
+		for( std::vector< TaskAverageTime >::const_iterator it = profiledTasks.begin(); it != profiledTasks.end(); ++it )
+		{
+			const Task* task = it->second;
+			const TaskProfile& profile = *task->m_profile;
+
+			outputStream << "\t[" << ( task->name().empty() ? String( "<unnamed>" ) : task->name() ) << "] priority " << task->priority()
+				<< " : \taverage " << profile.average() << "\tp99 " << profile.percentile99()
+				<< "\tshortest " << profile.shortest() << "\tbiggest " << profile.biggest();
+
+			if( frameBudget > 0 )
+			{
+				outputStream << "\t(" << ( 100 * profile.average() / frameBudget ) << "% of budget)";
+			}
+
+			if( task->m_deferralCount > 0 )
+			{
+				outputStream << "\tdeferred " << task->m_deferralCount << " times, " << task->m_consecutiveDeferralCount << " in a row";
+			}
+			outputStream << '\n';
+		}
+	}
+
+	String TaskManager::reportTaskProfiles( TimeValue frameBudget ) const
+	{
+		StringStream text;
+		reportTaskProfiles( text, frameBudget );
+		return text.str();
 	}
 
 	
@@ -3,17 +3,24 @@
 #pragma once
 
 #include <unordered_map>
-#include <list>
 #include <vector>
+#include <boost/thread/recursive_mutex.hpp>
+#include <boost/scoped_array.hpp>
+#include <boost/atomic.hpp>
+#include <boost/pool/poolfwd.hpp>
+#include <ostream>
 #include "GC_Common.h"
 #include "GC_String.h"
 #include "GC_Singleton.h"
 
 #include "GC_TaskProperties.h"
+#include "GC_TaskProfile.h"
 
 namespace gcore
 {
 	class Task;
+	class WorkerPool;
+	class TimeReferenceProvider;
 
 	/** The TaskManager is a tool that let you make your a (main) loop dynamic.
 		The purpose is to allow iterative processes to change through runtime.
@@ -23,6 +30,19 @@ namespace gcore
 		function is called.
 		The user application should then call executeTasks each cycle
 		of it's (main) loop to keep the tasks updated.
+		@par
+		By default the Tasks are executed sequentially by the thread calling executeTasks.
+		Using setExecutionMode, the Tasks with the same priority can be executed in parallel
+		by a WorkerPool, see TaskExecutionMode.
+		@par
+		Dependencies can be declared between registered Tasks using addTaskDependency : 
+		a Task will always be executed after the active Tasks it depends on, whatever their priorities.
+		@par
+		Using setFrameDeadline, the Tasks with the lowest priorities can be deferred to the next
+		executeTasks call once the frame budget is spent.
+		@par
+		Task execution times can be measured using enableTaskProfiling, to find the Tasks
+		that take the most of the frame time.
 		
 		@see Task
 	*/
@@ -31,8 +51,12 @@ namespace gcore
 		struct TaskCompare_AscendingPriority;
 
 	public:
-		typedef std::list< Task* > TaskList;
+		typedef std::vector< Task* > TaskList;
 		typedef std::tr1::unordered_map< String , Task*> TaskIndex;
+		typedef boost::object_pool< TaskProfile > TaskProfilePool;
+
+		/// Value of the indices a Task keep in the lists when not in the list.
+		static const std::size_t INVALID_INDEX = ~static_cast< std::size_t >( 0 );
 
 
 		/** Constructor. */
@@ -111,6 +135,26 @@ namespace gcore
 		/** Terminate all registered Tasks.	*/
 		void unregisterAllTasks();
 
+		/** Declare that a Task have to be executed after another one each cycle.
+			The dependencies are taken account in all execution modes, they only
+			apply if both Tasks are active.
+			@remark Adding a dependency that would create a cycle throws an exception.
+			@param task Task that will be executed after the dependency.
+			@param dependency Task that have to be executed before the task.
+		*/
+		void addTaskDependency( Task* task, Task* dependency );
+
+		/** Remove a dependency declared with addTaskDependency.
+			@param task Task that was executed after the dependency.
+			@param dependency Task that was executed before the task.
+		*/
+		void removeTaskDependency( Task* task, Task* dependency );
+
+		/** Remove all the dependencies of a Task : the Tasks it depends on and the Tasks that depend on it.
+			@remark Called on Task unregistration.
+		*/
+		void removeAllTaskDependencies( Task* task );
+
 		/** Change the priority of a Task.
 			If the Task is active, the active tasks list order will be sorted 
 			according to the new priority of the Task before execution.
@@ -138,18 +182,112 @@ namespace gcore
 			the changes on task order will 
 			be taken account only after the current cycle for the order. The paused and terminated
 			tasks will be not be executed in the same execution list.
+			@remark
+			In TEM_PARALLEL_STAGES mode, this is still true for Tasks paused or terminated by
+			a Task executed concurrently, but then the order of execution of the Tasks of the same
+			stage is not defined.
 		*/
 		void executeTasks();
 
+		/** Change the way the active Tasks are executed.
+			@param mode Execution mode to use from the next executeTasks call.
+			@param workerPool WorkerPool used to execute Tasks in parallel modes, must be
+				provided for those modes and must outlive it's use by this TaskManager.
+			@remark In parallel modes, Task execution code can be called by any thread of the 
+				WorkerPool and the Task manipulation methods of this TaskManager are protected by a
+				mutex, also locked while calling Task::onActivate, Task::onPaused, Task::onResumed 
+				and Task::onTerminate.
+			@see TaskExecutionMode
+		*/
+		void setExecutionMode( TaskExecutionMode mode, WorkerPool* workerPool = nullptr );
+
+		/// Current execution mode. @see setExecutionMode
+		TaskExecutionMode executionMode() const { return m_executionMode; }
+
+		/// WorkerPool used in parallel execution modes, or null if not set.
+		WorkerPool* workerPool() const { return m_workerPool; }
+
+		/** Stop executing the deferrable Tasks once a time budget is spent in an executeTasks call.
+			The deferrable Tasks that were not executed are carried over to the next executeTasks call : 
+			the deferrable Tasks are executed in turn, starting with the first Task deferred the last time,
+			so none of them starves as long as the other Tasks leave some time.
+			@param timeReference Time reference used to measure the time spent, must outlive it's use by this TaskManager.
+			@param frameBudget Time after which the deferrable Tasks are not executed anymore, counted from the start of executeTasks.
+			@param deferrablePriority Tasks with a priority greater or equal to this one are deferrable.
+			@remark Only used in TEM_SEQUENTIAL execution mode.
+			@remark If dependencies are declared, the deferrable Tasks are executed in dependency order instead of in turn,
+				and a deferrable Task that a non deferrable Task depends on is never deferred.
+			@see Task::deferralCount
+		*/
+		void setFrameDeadline( const TimeReferenceProvider& timeReference, TimeValue frameBudget, TaskPriority deferrablePriority );
+
+		/** Execute all the active Tasks in each executeTasks call again. @see setFrameDeadline
+		*/
+		void removeFrameDeadline();
+
+		/// True if a frame deadline is set. @see setFrameDeadline
+		bool hasFrameDeadline() const { return m_deadlineTimeReference != nullptr; }
+
+		/// Time after which the deferrable Tasks are not executed anymore. @see setFrameDeadline
+		TimeValue frameBudget() const { return m_frameBudget; }
+
+		/// Tasks with a priority greater or equal to this one are deferrable. @see setFrameDeadline
+		TaskPriority deferrablePriority() const { return m_deferrablePriority; }
+
+		/// Number of Tasks deferred by the last executeTasks call.
+		unsigned int deferredTaskCount() const { return m_deferredTaskCount; }
+
+		/** Start measuring the execution time of each registered Task, and of each executeTasks call.
+			@param timeReference Time reference used to measure the execution times, must outlive it's use
+				by this TaskManager. In parallel execution modes, it will be used by all the WorkerPool threads.
+			@see taskProfile @see frameProfile
+		*/
+		void enableTaskProfiling( const TimeReferenceProvider& timeReference );
+
+		/** Stop measuring the execution times and forget the recorded ones.
+		*/
+		void disableTaskProfiling();
+
+		/// True if the Tasks execution times are measured. @see enableTaskProfiling
+		bool isTaskProfilingEnabled() const { return m_profilingTimeReference != nullptr; }
+
+		/** Execution time statistics of a registered Task.
+			@return Statistics of the Task or null if profiling is not enabled.
+		*/
+		const TaskProfile* taskProfile( const Task* task ) const;
+
+		/** Execution time statistics of the executeTasks calls, while profiling is enabled.
+		*/
+		const TaskProfile& frameProfile() const { return m_frameProfile; }
+
+		/** Forget the execution times recorded until now.
+		*/
+		void clearTaskProfiles();
+
+		/** Append an ANSI text report about the execution times of the Tasks to the provided stream.
+			The Tasks are listed from the most expensive in average.
+			@param outputStream		Stream to append the text report to.
+			@param frameBudget		Time an executeTasks call should not exceed, or 0 to not compare with a budget.
+		*/
+		void reportTaskProfiles( std::ostream& outputStream, TimeValue frameBudget = 0 ) const;
+
+		/** Return an ANSI text report about the execution times of the Tasks.
+			@param frameBudget		Time an executeTasks call should not exceed, or 0 to not compare with a budget.
+		*/
+		String reportTaskProfiles( TimeValue frameBudget = 0 ) const;
+
 		/** Return the current active tasks list.
+			@remark The order of this list is not defined : a removed Task is replaced by the last Task of the list.
 		*/
 		const TaskList& activeTasksList() const { return m_activeTaskList; }
 
 		/** Return the current paused tasks list.
+			@remark The order of this list is not defined : a removed Task is replaced by the last Task of the list.
 		*/
 		const TaskList& pausedTaskList() const { return m_pausedTasksList; }
 
 		/** Return the current registered tasks list.
+			@remark The order of this list is not defined : a removed Task is replaced by the last Task of the list.
 		*/
 		const TaskList& registeredTasksList() const { return m_registeredTasksList; }
 
@@ -164,7 +302,80 @@ namespace gcore
 		*/
 		void deactivateTask( Task* task );
 
-		/** Comparison functor used to sort Tasks.
+		/** Update the execution list from the active list if it changed since last execution.
+		*/
+		void updateExecutionList();
+
+		/** Merge the pending tasks in the sorted execution list, removing the removed tasks.
+		*/
+		void mergeExecutionList();
+
+		/** Add a Task in a list, keeping it's index in the list in the provided Task member.
+		*/
+		static void insertInList( TaskList& taskList, Task* task, std::size_t Task::* taskIndex );
+
+		/** Remove a Task from a list in constant time : the last Task of the list takes it's place.
+		*/
+		static void removeFromList( TaskList& taskList, Task* task, std::size_t Task::* taskIndex );
+
+		/** True if the Task is in the registered list of this TaskManager. */
+		bool isRegisteredHere( const Task* task ) const;
+
+		/** Add an active Task in the tasks that will be merged in the execution list.
+		*/
+		void scheduleExecution( Task* task );
+
+		/** Execute a task, measuring it's execution time if profiled.
+		*/
+		void executeTask( Task* task );
+
+		/** Execute a task and record it's execution time.
+		*/
+		void executeProfiledTask( Task* task );
+
+		/** Destroy a task profile, or retire it until the end of the execution if the Tasks are executing.
+		*/
+		void destroyProfile( TaskProfile* profile );
+
+		/** Destroy the profiles retired while executing the Tasks.
+		*/
+		void destroyRetiredProfiles();
+
+		/** Execute the execution list until the frame deadline, deferring the deferrable tasks after it.
+		*/
+		void executeUntilDeadline( TimeValue frameStartTime );
+
+		/** Count a task as deferred.
+		*/
+		void deferTask( Task* task );
+
+		/** Execute the task at the provided index in the execution list, if not removed.
+			@remark Used by parallel execution.
+		*/
+		void executeTaskAt( std::size_t index );
+
+		/** Execute the execution list stage by stage in the WorkerPool.
+		*/
+		void executeStages();
+
+		/** Execute the execution list in the WorkerPool following the dependency graph.
+		*/
+		void executeGraph();
+
+		/** Execute a task of the dependency graph then schedule the dependent tasks that are ready.
+		*/
+		void executeGraphNode( std::size_t index );
+
+		/** Sort the execution list to respect the dependencies between active tasks
+			and build the dependency graph used by executeGraph.
+		*/
+		void sortExecutionDependencies();
+
+		/** True if there is a path of dependencies from the task to the other one.
+		*/
+		bool isDependentOn( Task* task, Task* dependency ) const;
+
+		/** Comparison functor used to sort Tasks : by priority, then by activation order.
 		*/
 		struct TaskCompare_AscendingPriority 
 		{
@@ -186,8 +397,90 @@ namespace gcore
 		/// Execution task list.
 		std::vector< Task* > m_executionTaskList;
 
+		/// Active tasks not in the execution list yet, they will be merged in it before the next execution.
+		TaskList m_pendingExecutionTasks;
+
+		/// Removed tasks from the execution list since last update (null entries).
+		std::size_t m_removedExecutionTaskCount;
+
+		/// Activation counter, used to keep the order of Tasks with the same priority.
+		unsigned long m_activationCount;
+
+		/// False if the execution list order is not only the priority order (dependencies), then it have to be sorted again on update.
+		bool m_executionListSorted;
+
+		/// Index of the first task of each stage in the execution list, followed by the execution list size.
+		std::vector< std::size_t > m_executionStages;
+
+		/// Dependent tasks of each task of the execution list (as execution list indices), see m_graphSuccessorsBegin.
+		std::vector< std::size_t > m_graphSuccessors;
+
+		/// Index in m_graphSuccessors of the first dependent task of each task of the execution list, followed by m_graphSuccessors size.
+		std::vector< std::size_t > m_graphSuccessorsBegin;
+
+		/// Number of active dependencies of each task of the execution list.
+		std::vector< unsigned int > m_graphDependencyCount;
+
+		/// Dependencies not executed yet for each task of the execution list, while executing the graph.
+		boost::scoped_array< boost::atomic< unsigned int > > m_graphPendingDependencies;
+
+		/// Size of m_graphPendingDependencies.
+		std::size_t m_graphPendingDependenciesSize;
+
+		/// Number of dependencies declared between registered tasks.
+		std::size_t m_dependencyCount;
+
 		/// True if we modified the active list since last execution
 		bool m_activeListChanged;
+
+		/// Current execution mode.
+		TaskExecutionMode m_executionMode;
+
+		/// Worker pool used in parallel execution modes.
+		WorkerPool* m_workerPool;
+
+		/// Time reference used to measure the Tasks execution times, or null if profiling is disabled.
+		const TimeReferenceProvider* m_profilingTimeReference;
+
+		/// Execution time statistics of the registered Tasks.
+		TaskProfilePool* m_taskProfilePool;
+
+		/// Execution time statistics of executeTasks.
+		TaskProfile m_frameProfile;
+
+		/// True while executeTasks is executing the Tasks : the profiles can't be destroyed until the end of the execution.
+		bool m_isExecutingTasks;
+
+		/// Profiles removed while executing the Tasks, with their pool, destroyed at the end of executeTasks.
+		std::vector< std::pair< TaskProfilePool*, TaskProfile* > > m_retiredProfiles;
+
+		/// Profile pools removed while executing the Tasks, destroyed at the end of executeTasks.
+		std::vector< TaskProfilePool* > m_retiredProfilePools;
+
+		/// Time reference used to measure the time spent by executeTasks, or null if no frame deadline is set.
+		const TimeReferenceProvider* m_deadlineTimeReference;
+
+		/// Time after which the deferrable tasks are not executed anymore.
+		TimeValue m_frameBudget;
+
+		/// Tasks with a priority greater or equal to this one are deferrable.
+		TaskPriority m_deferrablePriority;
+
+		/// Index of the first deferrable task in the execution list, or it's size if the list is not sorted by priority.
+		std::size_t m_firstDeferrableIndex;
+
+		/// True for the tasks of the execution list that can be deferred : deferrable and no non deferrable task depends on them.
+		std::vector< bool > m_deferrableTasks;
+
+		/// Index of the first deferrable task deferred by the last execution, or INVALID_INDEX.
+		std::size_t m_firstDeferredIndex;
+
+		/// Number of tasks deferred by the last execution.
+		unsigned int m_deferredTaskCount;
+
+		/// Protect the tasks lists against concurrent Task manipulations.
+		mutable boost::recursive_mutex m_stateMutex;
+		typedef boost::recursive_mutex::scoped_lock StateLock;
 	};
 
 }
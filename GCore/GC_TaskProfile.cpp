@@ -0,0 +1,76 @@
+#include <algorithm>
+#include <functional>
+#include "GC_TaskProfile.h"
+
+namespace gcore
+{
+
+	TaskProfile::TaskProfile()
+		: m_nextSample( 0 )
+		, m_sampleCount( 0 )
+		, m_executionCount( 0 )
+	{
+		
+	}
+
+	void TaskProfile::clear()
+	{
+		m_nextSample = 0;
+		m_sampleCount = 0;
+		m_executionCount = 0;
+	}
+
+	TimeValue TaskProfile::last() const
+	{
+		if( m_sampleCount == 0 ) return 0;
+		return m_samples[ ( m_nextSample + SAMPLE_COUNT - 1 ) % SAMPLE_COUNT ];
+	}
+
+	TimeValue TaskProfile::shortest() const
+	{
+		if( m_sampleCount == 0 ) return 0;
+		return *std::min_element( m_samples, m_samples + m_sampleCount );
+	}
+
+	TimeValue TaskProfile::biggest() const
+	{
+		if( m_sampleCount == 0 ) return 0;
+		return *std::max_element( m_samples, m_samples + m_sampleCount );
+	}
+
+	TimeValue TaskProfile::average() const
+	{
+		if( m_sampleCount == 0 ) return 0;
+
+		TimeValue timeSum = 0;
+		for( unsigned int i = 0; i < m_sampleCount; ++i )
+		{
+			timeSum += m_samples[i];
+		}
+
+		return timeSum / m_sampleCount;
+	}
+
+	TimeValue TaskProfile::percentile( unsigned int percent ) const
+	{
+		GC_ASSERT( percent <= 100, "Invalid percentile asked : " << percent );
+		if( m_sampleCount == 0 ) return 0;
+
+		// work on a copy : the samples have to stay in record order
+		TimeValue sortedSamples[ SAMPLE_COUNT ];
+		std::copy( m_samples, m_samples + m_sampleCount, sortedSamples );
+
+		// nearest rank
+		const unsigned int rank = ( percent * m_sampleCount + 99 ) / 100;
+		const unsigned int index = rank > 0 ? rank - 1 : 0;
+		std::nth_element( sortedSamples, sortedSamples + index, sortedSamples + m_sampleCount );
+
+		return sortedSamples[ index ];
+	}
+
+	unsigned int TaskProfile::countOver( TimeValue time ) const
+	{
+		return static_cast< unsigned int >( std::count_if( m_samples, m_samples + m_sampleCount, std::bind2nd( std::greater< TimeValue >(), time ) ) );
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,92 @@
+#ifndef GCORE_TASKPROFILE_H
+#define GCORE_TASKPROFILE_H
+#pragma once
+
+#include "GC_Common.h"
+#include "GC_Time.h"
+
+namespace gcore
+{
+	/** Execution time statistics over the last executions of a Task (or of all the Tasks).
+		The last SAMPLE_COUNT execution times are kept in a fixed size ring, so recording
+		an execution time never allocates memory.
+		@see TaskManager::enableTaskProfiling
+	*/
+	class GCORE_API TaskProfile
+	{
+	public:
+
+		/// Number of execution times kept to compute the statistics.
+		static const unsigned int SAMPLE_COUNT = 128;
+
+		/** Constructor. */
+		TaskProfile();
+
+		/** Record an execution time, replacing the oldest one if SAMPLE_COUNT times are already kept.
+			@param executionTime Time spent executing.
+		*/
+		void record( TimeValue executionTime )
+		{
+			m_samples[ m_nextSample ] = executionTime;
+			m_nextSample = ( m_nextSample + 1 ) % SAMPLE_COUNT;
+			if( m_sampleCount < SAMPLE_COUNT ) ++m_sampleCount;
+			++m_executionCount;
+		}
+
+		/** Forget all the recorded execution times. */
+		void clear();
+
+		/// Number of execution times kept, at most SAMPLE_COUNT.
+		unsigned int sampleCount() const { return m_sampleCount; }
+
+		/// Number of execution times recorded since creation or last clear.
+		unsigned long executionCount() const { return m_executionCount; }
+
+		/** @return The last recorded execution time or 0 if no records.
+		*/
+		TimeValue last() const;
+
+		/** @return The shortest kept execution time or 0 if no records.
+		*/
+		TimeValue shortest() const;
+
+		/** @return The biggest kept execution time or 0 if no records.
+		*/
+		TimeValue biggest() const;
+
+		/** @return The average of the kept execution times or 0 if no records.
+		*/
+		TimeValue average() const;
+
+		/** @return The kept execution time that the given percentage of kept execution times don't exceed, or 0 if no records.
+			@param percent Percentage of execution times, between 0 and 100.
+		*/
+		TimeValue percentile( unsigned int percent ) const;
+
+		/** @return The kept execution time that 99% of kept execution times don't exceed, or 0 if no records.
+		*/
+		TimeValue percentile99() const { return percentile( 99 ); }
+
+		/** @return The number of kept execution times bigger than the provided time.
+		*/
+		unsigned int countOver( TimeValue time ) const;
+
+	private:
+
+		/// Kept execution times.
+		TimeValue m_samples[ SAMPLE_COUNT ];
+
+		/// Index of the next sample to write in m_samples.
+		unsigned int m_nextSample;
+
+		/// Number of valid samples in m_samples.
+		unsigned int m_sampleCount;
+
+		/// Number of recorded execution times.
+		unsigned long m_executionCount;
+
+	};
+
+}
+
+#endif
\ No newline at end of file
@@ -24,6 +24,26 @@ namespace gcore
 
 	};	
 
+	/// Way a TaskManager execute it's active Tasks.
+	enum TaskExecutionMode
+	{
+		/// Tasks are executed one after the other in ascending priority order by the calling thread.
+		TEM_SEQUENTIAL = 0,
+
+		/** Tasks with the same priority form a stage executed in parallel by a WorkerPool.
+			Stages are still executed in ascending priority order.
+		*/
+		TEM_PARALLEL_STAGES,
+
+		/** Tasks are executed in parallel by a WorkerPool as soon as all the Tasks they
+			depend on have been executed. Priorities don't order the execution : the Tasks ready at the
+			same time run concurrently, only the dependencies order them.
+			@see TaskManager::addTaskDependency
+		*/
+		TEM_DEPENDENCY_GRAPH,
+
+	};
+
 }
 
 #endif
\ No newline at end of file
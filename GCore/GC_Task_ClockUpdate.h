@@ -11,9 +11,12 @@ namespace gcore
 {
 
 	/** Task that update an ClockManager by calling it's ClockManager::updateClocks() function each cycle.
+		When the ClockManager is in fixed-step mode, the FixedStepTask following it 
+		have to be executed after this task.
 
 	@see Task
 	@see ClockManager
+	@see FixedStepTask
 
 	*/
 	class GCORE_API Task_ClockUpdate  : public Task
@@ -2,6 +2,8 @@
 #define GCORE_TIME_H
 #pragma once
 
+#include <boost/cstdint.hpp>
+
 #include "GC_Common.h"
 
 namespace gcore
@@ -17,6 +19,9 @@ namespace gcore
 	/// Type for time flow factor value.
 	typedef double TimeFlowFactor;
 
+	/// Type for time in integer ticks, as provided by a TimeReferenceProvider.
+	typedef boost::int64_t TimeTicks;
+
 }
 
 #endif
\ No newline at end of file
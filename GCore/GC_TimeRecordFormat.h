@@ -0,0 +1,116 @@
+#ifndef GCORE_TIMERECORDFORMAT_H
+#define GCORE_TIMERECORDFORMAT_H
+#pragma once
+
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <boost/cstdint.hpp>
+
+#include "GC_Common.h"
+#include "GC_Time.h"
+
+namespace gcore
+{
+	/* Binary format of the time queries recorded by RecordingTimeProvider and replayed by ReplayTimeProvider.
+		@par
+		Header : the 4 bytes "GCTR", a version byte, then the ticks per second of the recorded provider as a varint.
+		@par
+		Then one record by query : the difference with the previous value of the same kind of query 
+		(bit pattern of the TimeValue for time queries, tick value for tick queries), zigzag encoded
+		then written as a varint of 7 bits groups, except the first byte that holds the kind of query
+		in it's bit 6 and only 6 bits of the value. Consecutive queries have close values : 
+		records are usually 2 to 6 bytes long instead of 8.
+		@see RecordingTimeProvider @see ReplayTimeProvider
+	*/
+
+	/// Kind of time query recorded.
+	enum TimeRecordKind
+	{
+		/// getTimeSinceStart() query.
+		TRK_TIME = 0,
+
+		/// getTicksSinceStart() query.
+		TRK_TICKS = 1,
+
+	};
+
+	/// Magic bytes at the start of a time record stream.
+	static const char TIME_RECORD_MAGIC[4] = { 'G', 'C', 'T', 'R' };
+
+	/// Version of the time record format.
+	static const unsigned char TIME_RECORD_VERSION = 1;
+
+	/// Bit pattern of a time value, to record it exactly.
+	inline boost::uint64_t timeValueBits( TimeValue timeValue )
+	{
+		boost::uint64_t bits;
+		std::memcpy( &bits, &timeValue, sizeof( bits ) );
+		return bits;
+	}
+
+	/// Time value of a bit pattern.
+	inline TimeValue timeValueFromBits( boost::uint64_t bits )
+	{
+		TimeValue timeValue;
+		std::memcpy( &timeValue, &bits, sizeof( timeValue ) );
+		return timeValue;
+	}
+
+	/// Map a difference of values (wrapping) to an unsigned value, small when the difference is close to 0.
+	inline boost::uint64_t zigzagEncode( boost::uint64_t difference )
+	{
+		return ( difference << 1 ) ^ ( boost::uint64_t( 0 ) - ( difference >> 63 ) );
+	}
+
+	/// Inverse of zigzagEncode.
+	inline boost::uint64_t zigzagDecode( boost::uint64_t value )
+	{
+		return ( value >> 1 ) ^ ( boost::uint64_t( 0 ) - ( value & 1 ) );
+	}
+
+	/** Write a varint, the first byte holding only firstByteBits bits of the value and the given flags.
+		@return False if the stream failed.
+	*/
+	inline bool writeVarint( std::ostream& stream, boost::uint64_t value, unsigned int firstByteBits = 7, unsigned char firstByteFlags = 0 )
+	{
+		char buffer[ 11 ];
+		std::size_t size = 0;
+
+		buffer[ size ] = static_cast< char >( firstByteFlags | ( value & ( ( 1u << firstByteBits ) - 1 ) ) );
+		value >>= firstByteBits;
+		while( value != 0 )
+		{
+			buffer[ size++ ] |= 0x80;
+			buffer[ size ] = static_cast< char >( value & 0x7F );
+			value >>= 7;
+		}
+
+		stream.write( buffer, size + 1 );
+		return !stream.fail();
+	}
+
+	/** Read a varint written by writeVarint.
+		@param firstByte First byte of the varint, already read from the stream.
+		@return False if the stream ended or the varint is invalid.
+	*/
+	inline bool readVarint( std::istream& stream, unsigned char firstByte, boost::uint64_t& value, unsigned int firstByteBits = 7 )
+	{
+		value = firstByte & ( ( 1u << firstByteBits ) - 1 );
+		unsigned int shift = firstByteBits;
+		unsigned char byte = firstByte;
+		while( byte & 0x80 )
+		{
+			const int nextByte = stream.get();
+			if( nextByte == std::char_traits< char >::eof() || shift >= 64 ) return false;
+
+			byte = static_cast< unsigned char >( nextByte );
+			value |= static_cast< boost::uint64_t >( byte & 0x7F ) << shift;
+			shift += 7;
+		}
+		return true;
+	}
+
+}
+
+#endif
\ No newline at end of file
@@ -22,6 +22,24 @@ namespace gcore
 		*/
 		virtual TimeValue getTimeSinceStart() const = 0;
 
+		/** Ticks passed since the start, in the resolution of the provider.
+			Use it to measure short time spans : the difference of two tick values is exact,
+			while the difference of two big time values loose precision.
+			@remark The default implementation converts getTimeSinceStart() in nanoseconds.
+			@return Time value (in ticks). @see getTicksPerSecond
+		*/
+		virtual TimeTicks getTicksSinceStart() const { return static_cast< TimeTicks >( getTimeSinceStart() * 1000000000.0 ); }
+
+		/** Number of ticks in a second.
+			@remark The default implementation provides nanoseconds.
+		*/
+		virtual TimeTicks getTicksPerSecond() const { return 1000000000; }
+
+		/** Convert ticks, usually a difference of two tick values, to a time value.
+			@return Time value (in seconds).
+		*/
+		TimeValue ticksToTime( TimeTicks ticks ) const { return static_cast< TimeValue >( ticks ) / static_cast< TimeValue >( getTicksPerSecond() ); }
+
 
 		/** Destructor.
 		*/
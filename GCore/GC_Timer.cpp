@@ -4,13 +4,22 @@
 namespace gcore
 {
 
-	Timer::Timer( const String& name, const Clock& clock ) : m_name( name )
-		, m_clock( clock )
+	Timer::Timer( const String& name, const Clock& clock, TimerManager& timerManager ) : m_name( name )
 		, m_triggerCount( 0 )
-		, m_waitTime( 0 )
 		, m_timeSinceLastTrigger ( 0 )
-		, m_timerListenerListChanged( false )
+		, m_startTime( 0 )
+		, m_isRunning( false )
+		, m_isTriggering( false )
+		, m_waitTime( 0 )
 		, m_triggerOnce( false )
+		, m_clock( clock )
+		, m_timerManager( timerManager )
+		, m_clockTimers( nullptr )
+		, m_dueIndex( TimerManager::INVALID_INDEX )
+		, m_firedIndex( TimerManager::INVALID_INDEX )
+		, m_listIndex( TimerManager::INVALID_INDEX )
+		, m_isDestroyed( false )
+		, m_timerListenerListChanged( false )
 	{
 
 	}
@@ -42,43 +51,99 @@ namespace gcore
 		m_timerListenerList.clear();
 	}
 
-	void Timer::update()
+	void Timer::trigger()
 	{
-		if( m_waitTime == 0 ) return;	// wait time 0 is equal to no wait time set
-		if( m_triggerOnce && m_triggerCount > 0 ) return; // already triggered one time
+		GC_ASSERT( m_isRunning, "Tried to trigger a timer that is not running!" );
 
-		// update time passed
-		m_timeSinceLastTrigger += m_clock.deltaTime();
+		m_isTriggering = true;
 
-		while( m_timeSinceLastTrigger >= m_waitTime ) // make sure we do more than one trigger if necessary
+		try
 		{
-			// we have to trigger
-			++m_triggerCount;
-
-			// trigger all listeners
-			if( m_timerListenerListChanged )
-			{
-				m_triggerList = m_timerListenerList;
-				m_timerListenerListChanged = false;
-			}
-
-			const std::size_t listenerCount = m_triggerList.size();
-			for( unsigned int i = 0; i < listenerCount; ++i )
+			while( m_isRunning && TimerManager::clockElapsedTime( *m_clockTimers ) - m_startTime >= m_waitTime ) // make sure we do more than one trigger if necessary
 			{
-				TimerListener* timerListener = m_triggerList[i];
-				timerListener->onTimerTrigger( *this );
+				// we have to trigger
+				++m_triggerCount;
+
+				// time passed
+				m_startTime += m_waitTime;
+
+				if( m_triggerOnce ) 
+				{
+					applyChanges( getTimeSinceLastTrigger() ); // trigger only one time!
+				}
+
+				// trigger all listeners
+				if( m_timerListenerListChanged )
+				{
+					m_triggerList = m_timerListenerList;
+					m_timerListenerListChanged = false;
+				}
+
+				const std::size_t listenerCount = m_triggerList.size();
+				for( unsigned int i = 0; i < listenerCount; ++i )
+				{
+					TimerListener* timerListener = m_triggerList[i];
+					timerListener->onTimerTrigger( *this );
+				}
 			}
-
-			// time passed
-			m_timeSinceLastTrigger -= m_waitTime;
-
-			if( m_triggerOnce ) break; // trigger only one time!
 		}
+		catch( ... )
+		{
+			m_isTriggering = false;
+			if( m_isRunning ) m_timerManager.scheduleTimer( *this );
+			throw;
+		}
+
+		m_isTriggering = false;
+		if( m_isRunning ) m_timerManager.scheduleTimer( *this ); // wait for the next trigger
 	}
 
 	void Timer::reset()
 	{
 		m_triggerCount = 0;
-		m_timeSinceLastTrigger = 0;
+		applyChanges( 0 );
+	}
+
+	void Timer::setWaitTime( const TimeValue& waitTime )
+	{
+		const TimeValue timeSinceLastTrigger = getTimeSinceLastTrigger();
+		m_waitTime = waitTime;
+		applyChanges( timeSinceLastTrigger );
+	}
+
+	void Timer::setTriggerOnce( bool triggerOnce )
+	{
+		const TimeValue timeSinceLastTrigger = getTimeSinceLastTrigger();
+		m_triggerOnce = triggerOnce;
+		applyChanges( timeSinceLastTrigger );
+	}
+
+	TimeValue Timer::getTimeSinceLastTrigger() const
+	{
+		if( m_isRunning ) return TimerManager::clockElapsedTime( *m_clockTimers ) - m_startTime;
+		return m_timeSinceLastTrigger;
+	}
+
+	bool Timer::shouldRun() const
+	{
+		return m_waitTime > 0						// wait time 0 is equal to no wait time set
+			&& !( m_triggerOnce && m_triggerCount > 0 ) // already triggered one time
+			&& m_clockTimers != nullptr;			// clock destroyed
+	}
+
+	void Timer::applyChanges( TimeValue timeSinceLastTrigger )
+	{
+		m_timerManager.unscheduleTimer( *this );
+
+		m_isRunning = shouldRun();
+		if( m_isRunning )
+		{
+			m_startTime = TimerManager::clockElapsedTime( *m_clockTimers ) - timeSinceLastTrigger;
+			if( !m_isTriggering ) m_timerManager.scheduleTimer( *this ); // else scheduled once triggered
+		}
+		else
+		{
+			m_timeSinceLastTrigger = timeSinceLastTrigger;
+		}
 	}
 }
\ No newline at end of file
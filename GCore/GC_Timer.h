@@ -9,6 +9,7 @@
 #include "GC_Common.h"
 #include "GC_Time.h"
 #include "GC_TimerManager.h"
+#include "GC_TimingWheel.h"
 
 
 namespace gcore
@@ -51,6 +52,9 @@ namespace gcore
 
 	/** Trigger listeners when a specified amount of time passed.
 		Managed by TimerManager.
+		@remark The time passed is the sum of the delta times of the clock on each TimerManager update,
+		so the time flow factor of the clock applies.
+		@remark A Timer can be destroyed by it's own listeners, it is then deleted once all of them are called.
 		@see TimerManager
 
 	*/
@@ -71,12 +75,6 @@ namespace gcore
 		void unregisterAllListeners();
 
 
-		/** Verify passed time since last update and trigger listeners if
-			the specified time passed. 
-			@remark Call this method one time by clock update.
-		*/
-		void update();
-
 		/** Reset the time counting data.
 		*/
 		void reset();
@@ -91,19 +89,25 @@ namespace gcore
 		/** Time span to wait before trigger.
 			@remark 0 Wait time will deactivate this timer.
 		*/
-		void setWaitTime( const TimeValue& waitTime ){ m_waitTime = waitTime; }
+		void setWaitTime( const TimeValue& waitTime );
+
+		/// Time passed since the last trigger (or creation or reset), not counting the time this timer was inactive.
+		TimeValue getTimeSinceLastTrigger() const;
 
 		/** Name of this timer or empty string if no name set on creation.
 		*/
 		const String& getName() const { return m_name; }
 
+		/// Handle identifying this timer in it's manager.
+		const TimerHandle& getHandle() const { return m_handle; }
+
 		/** True if this timer have to trigger only one time and then do nothing.
 		*/
 		bool isTriggerOnce() const { return m_triggerOnce; }
 
 		/** True if this timer have to trigger only one time and then do nothing.
 		*/
-		void setTriggerOnce( bool triggerOnce = true ) { m_triggerOnce = triggerOnce; }
+		void setTriggerOnce( bool triggerOnce = true );
 
 	protected:
 		
@@ -115,9 +119,18 @@ namespace gcore
 		/// Count how many time this timer triggered.
 		unsigned long m_triggerCount;
 
-		/// Time since the last time we triggered.
+		/// Time since the last time we triggered, while not running.
 		TimeValue m_timeSinceLastTrigger;
 
+		/// Elapsed time of the clock when the time since the last trigger was 0, while running.
+		TimeValue m_startTime;
+
+		/// True if the time is counting : wait time set, clock alive and not triggered if trigger once.
+		bool m_isRunning;
+
+		/// True while triggering the listeners.
+		bool m_isTriggering;
+
 		/// Time span to wait before trigger.
 		TimeValue m_waitTime;
 
@@ -127,18 +140,48 @@ namespace gcore
 		/// Clock used as a time reference provider.
 		const Clock& m_clock;
 
+		/// Manager that created this timer.
+		TimerManager& m_timerManager;
+
+		/// Timers of the clock in the manager, or null if the clock was destroyed.
+		TimerManager::ClockTimers* m_clockTimers;
+
+		/// Scheduling in the timers of the clock.
+		TimingWheel< Timer* >::Handle m_wheelHandle;
+		std::size_t m_dueIndex;
+		std::size_t m_firedIndex;
+
+		/// Handle of this timer.
+		TimerHandle m_handle;
+
+		/// Index in the timer list of the manager.
+		std::size_t m_listIndex;
+
+		/// True if destroyed while triggering : it will be deleted once triggered.
+		bool m_isDestroyed;
+
 		/// Listeners registered to this timer.
 		std::vector< TimerListener* > m_timerListenerList;
 		bool m_timerListenerListChanged;
 		std::vector< TimerListener* > m_triggerList;
 
 		friend class TimerManager;
-		friend typedef TimerManager::TimerPool;
 
 		/** Constructor.
 		@param clock Clock used as a time reference.
 		*/
-		Timer( const String& name, const Clock& clock);
+		Timer( const String& name, const Clock& clock, TimerManager& timerManager );
+
+		/// True if the time should be counting.
+		bool shouldRun() const;
+
+		/// Update the schedule after a change of the wait time, trigger once or clock.
+		void applyChanges( TimeValue timeSinceLastTrigger );
+
+		/** Trigger the listeners as many times as the time passed allows.
+			@remark Called by TimerManager when the wait time passed.
+		*/
+		void trigger();
 
 		/** Destructor.
 		*/
@@ -1,17 +1,208 @@
-
-#include <boost/pool/object_pool.hpp>
+#include <cmath>
+#include <new>
+#include <boost/pool/pool.hpp>
 
 #include "GC_TimerManager.h"
 #include "GC_Timer.h"
+#include "GC_Clock.h"
+#include "GC_ClockDataMap.h"
+#include "GC_TimingWheel.h"
 
 namespace gcore
 {
+	/** Running timers of a clock.
+		Timers are scheduled in the wheel at the bucket of their due time, 
+		then checked exactly once the bucket is reached.
+	*/
+	struct TimerManager::ClockTimers
+	{
+		typedef TimingWheel< Timer* > TimerWheel;
+
+		ClockTimers( const Clock& c ) : clock( c ), elapsedTime( 0 ), timerCount( 0 ) {}
+
+		const Clock& clock;
+
+		/// Sum of the clock delta times since the creation.
+		TimeValue elapsedTime;
+
+		/// Running timers waiting for their bucket.
+		TimerWheel wheel;
+
+		/** Running timers which bucket is reached, waiting for their exact due time.
+			Their time data are copied in parallel arrays to be checked in a tight loop.
+		*/
+		TimerList dueTimers;
+		std::vector< TimeValue > dueStartTimes;
+		std::vector< TimeValue > dueWaitTimes;
+
+		/// Indices of the due timers found fired by the last check, in increasing order.
+		std::vector< std::size_t > firedDueIndices;
+
+		/// Timers created with this clock.
+		std::size_t timerCount;
+
+		/// Expired timers of the last wheel advance.
+		TimerList expiredTimers;
+
+		/** Find the due timers which wait time passed.
+			@remark Branchless : the index is always written, the count only grows for fired timers.
+		*/
+		void findFiredTimers()
+		{
+			const std::size_t dueCount = dueTimers.size();
+			firedDueIndices.resize( dueCount );
+			if( dueCount == 0 ) return;
+
+			const TimeValue time = elapsedTime;
+			const TimeValue* startTimes = &dueStartTimes[0];
+			const TimeValue* waitTimes = &dueWaitTimes[0];
+			std::size_t* firedIndices = &firedDueIndices[0];
+
+			std::size_t firedCount = 0;
+			for( std::size_t i = 0; i < dueCount; ++i )
+			{
+				firedIndices[ firedCount ] = i;
+				firedCount += ( time - startTimes[i] >= waitTimes[i] ) ? 1 : 0;
+			}
+
+			firedDueIndices.resize( firedCount );
+		}
+
+		/** Remove a due timer, the last due timer take it's place.
+			@return Timer moved at the index, or null if it was the last one.
+		*/
+		Timer* removeDueTimer( std::size_t index )
+		{
+			Timer* movedTimer = nullptr;
+			const std::size_t lastIndex = dueTimers.size() - 1;
+			if( index != lastIndex )
+			{
+				movedTimer = dueTimers[ lastIndex ];
+				dueTimers[ index ] = movedTimer;
+				dueStartTimes[ index ] = dueStartTimes[ lastIndex ];
+				dueWaitTimes[ index ] = dueWaitTimes[ lastIndex ];
+			}
+			dueTimers.pop_back();
+			dueStartTimes.pop_back();
+			dueWaitTimes.pop_back();
+			return movedTimer;
+		}
+	};
+
+	/** Timers of each clock, stopping the timers of destroyed clocks.
+	*/
+	struct TimerManager::Schedule : public ClockDataMap< ClockTimers >
+	{
+		Schedule( TimerManager& manager ) : timerManager( manager ) {}
+
+		TimerManager& timerManager;
+
+		ClockTimers& acquire( const Clock& clock )
+		{
+			ClockTimers& clockTimers = findOrCreate( clock );
+			++clockTimers.timerCount;
+			return clockTimers;
+		}
+
+		void release( const Clock& clock )
+		{
+			ClockTimers* clockTimers = find( clock );
+			if( clockTimers == nullptr ) return; // clock already destroyed
+
+			GC_ASSERT( clockTimers->timerCount > 0, "Released more timers than acquired!" );
+			if( --clockTimers->timerCount == 0 )
+			{
+				destroy( clock );
+			}
+		}
+
+	protected:
+
+		void onClockDataDestroyed( ClockTimers& clockTimers )
+		{
+			timerManager.stopTimers( clockTimers );
+		}
+	};
+
+
+	/** Callbacks waiting for their trigger once timer.
+	*/
+	struct TimerManager::ScheduledCallbacks : public TimerListener
+	{
+		struct ScheduledCallback
+		{
+			TimerHandle timerHandle;
+			TimerCallback callback;
+		};
+
+		typedef std::tr1::unordered_map< TimerCallbackId, ScheduledCallback > CallbackIndex;
+		typedef std::tr1::unordered_map< std::size_t, TimerCallbackId > TimerIndex;
+
+		ScheduledCallbacks( TimerManager& manager ) : timerManager( manager ) {}
+
+		TimerManager& timerManager;
+
+		/// Callbacks by id.
+		CallbackIndex callbacks;
+
+		/// Callback ids by timer handle index.
+		TimerIndex callbackTimers;
+
+		void schedule( const CallbackCommand& command )
+		{
+			if( command.timeSpan <= 0 )
+			{
+				command.callback(); // nothing to wait for
+				return;
+			}
+
+			Timer* timer = timerManager.createTimer( *command.clock );
+			timer->setTriggerOnce();
+			timer->setWaitTime( command.timeSpan );
+			timer->registerListener( this );
+
+			ScheduledCallback& scheduledCallback = callbacks[ command.callbackId ];
+			scheduledCallback.timerHandle = timer->getHandle();
+			scheduledCallback.callback = command.callback;
+			callbackTimers[ scheduledCallback.timerHandle.index ] = command.callbackId;
+		}
+
+		void cancel( TimerCallbackId callbackId )
+		{
+			CallbackIndex::iterator it = callbacks.find( callbackId );
+			if( it == callbacks.end() ) return; // already called or cancelled
+
+			timerManager.destroyTimer( it->second.timerHandle );
+			callbackTimers.erase( it->second.timerHandle.index );
+			callbacks.erase( it );
+		}
+
+		void onTimerTrigger( Timer& timer )
+		{
+			TimerIndex::iterator timerIt = callbackTimers.find( timer.getHandle().index );
+			GC_ASSERT( timerIt != callbackTimers.end(), "Triggered a timer without scheduled callback!" );
+
+			CallbackIndex::iterator it = callbacks.find( timerIt->second );
+			TimerCallback callback;
+			callback.swap( it->second.callback );
+			callbacks.erase( it );
+			callbackTimers.erase( timerIt );
+
+			timerManager.destroyTimer( &timer ); // deleted once triggered
+			callback();
+		}
+	};
 
 
 	TimerManager::TimerManager( size_t reserveTimerCount )
-		: m_timerPool( new TimerPool(reserveTimerCount) )
+		: m_schedule( nullptr )
+		, m_timerResolution( 0.001 )
+		, m_lastCallbackId( 0 )
+		, m_scheduledCallbacks( nullptr )
+		, m_timerPool( new TimerPool( sizeof( Timer ), reserveTimerCount ) )
 	{
-		
+		m_schedule = new Schedule( *this );
+		m_scheduledCallbacks = new ScheduledCallbacks( *this );
 	}
 
 	TimerManager::~TimerManager()
@@ -21,6 +212,8 @@ namespace gcore
 			destroyAllTimers();
 		}
 
+		delete m_scheduledCallbacks;
+		delete m_schedule;
 		delete m_timerPool;
 	}
 
@@ -29,11 +222,39 @@ namespace gcore
 		GC_ASSERT( m_namedTimersIndex.find( name ) == m_namedTimersIndex.end() , String("Tried to create a timer with a name already used! Name : ") + name );
 
 		// create the timer
-		Timer* timer = m_timerPool->construct( name, clock );
+		void* timerMemory = m_timerPool->malloc();
+		if( timerMemory == nullptr ) throw std::bad_alloc();
+
+		Timer* timer = nullptr;
+		try
+		{
+			timer = new( timerMemory ) Timer( name, clock, *this );
+		}
+		catch( ... )
+		{
+			m_timerPool->free( timerMemory );
+			throw;
+		}
+
+		timer->m_clockTimers = &m_schedule->acquire( clock );
 
 		// register the timer 
+		timer->m_listIndex = m_timerList.size();
 		m_timerList.push_back( timer );
 
+		if( m_freeTimerSlots.empty() )
+		{
+			m_freeTimerSlots.push_back( m_timerSlots.size() );
+			m_timerSlots.push_back( TimerSlot() );
+		}
+		const std::size_t slotIndex = m_freeTimerSlots.back();
+		m_freeTimerSlots.pop_back();
+
+		TimerSlot& slot = m_timerSlots[ slotIndex ];
+		slot.timer = timer;
+		timer->m_handle.index = slotIndex;
+		timer->m_handle.generation = slot.generation;
+
 		if( timer->getName() != "" )
 		{
 			// register in the index
@@ -48,33 +269,73 @@ namespace gcore
 	{
 		GC_ASSERT( timer != nullptr, "Tried to destroy a null timer!" );
 		GC_ASSERT( m_timerPool->is_from( timer ) , String( "Tried to destroy a timer that was not created by this manager! Timer name : ") + timer->getName() );
+		GC_ASSERT( !timer->m_isDestroyed, String( "Tried to destroy a timer already destroyed! Timer name : ") + timer->getName() );
 
-		// unregister timer
-		if( timer->getName() != "")
-		{
-			m_namedTimersIndex.erase( m_namedTimersIndex.find( timer->getName() ) );
-		}
+		releaseTimer( *timer );
 
-		m_timerList.erase( std::remove( m_timerList.begin(), m_timerList.end(), timer ), m_timerList.end() );
+		// then destroy timer, once triggered if it is triggering
+		if( timer->m_isTriggering ) timer->m_isDestroyed = true;
+		else deleteTimer( timer );
 
-		// then destroy timer
-		m_timerPool->destroy( timer );
+	}
 
+	bool TimerManager::destroyTimer( const TimerHandle& handle )
+	{
+		Timer* timer = getTimer( handle );
+		if( timer == nullptr ) return false;
+
+		destroyTimer( timer );
+		return true;
 	}
 
 	void TimerManager::destroyAllTimers()
 	{
-		m_namedTimersIndex.clear();
-		
-		const std::size_t timerCount = m_timerList.size();
-		for( std::size_t i= 0; i < timerCount; ++i )
+		while( !m_timerList.empty() )
+		{
+			destroyTimer( m_timerList.back() );
+		}
+
+		// their timers are destroyed
+		m_scheduledCallbacks->callbacks.clear();
+		m_scheduledCallbacks->callbackTimers.clear();
+
+	}
+
+	void TimerManager::releaseTimer( Timer& timer )
+	{
+		// unregister timer
+		if( timer.getName() != "")
 		{
-			m_timerPool->destroy( m_timerList[i] );
+			m_namedTimersIndex.erase( m_namedTimersIndex.find( timer.getName() ) );
 		}
 
-		m_timerList.clear();
+		// the last timer take it's place in the list
+		Timer* lastTimer = m_timerList.back();
+		m_timerList[ timer.m_listIndex ] = lastTimer;
+		lastTimer->m_listIndex = timer.m_listIndex;
+		m_timerList.pop_back();
+		timer.m_listIndex = INVALID_INDEX;
 
+		// invalidate the handle
+		TimerSlot& slot = m_timerSlots[ timer.m_handle.index ];
+		slot.timer = nullptr;
+		++slot.generation;
+		m_freeTimerSlots.push_back( timer.m_handle.index );
 
+		// stop it
+		unscheduleTimer( timer );
+		if( timer.m_clockTimers != nullptr )
+		{
+			timer.m_clockTimers = nullptr;
+			m_schedule->release( timer.m_clock );
+		}
+		timer.m_isRunning = false;
+	}
+
+	void TimerManager::deleteTimer( Timer* timer )
+	{
+		timer->~Timer();
+		m_timerPool->free( timer );
 	}
 
 	Timer* TimerManager::getTimer( const String& name )
@@ -85,16 +346,203 @@ namespace gcore
 		else return nullptr;
 	}
 
-	void TimerManager::updateTimers()
+	Timer* TimerManager::getTimer( const TimerHandle& handle ) const
+	{
+		if( handle.index >= m_timerSlots.size() ) return nullptr;
+
+		const TimerSlot& slot = m_timerSlots[ handle.index ];
+		if( slot.generation != handle.generation ) return nullptr;
+
+		return slot.timer;
+	}
+
+	void TimerManager::timerResolution( TimeValue resolution )
+	{
+		GC_ASSERT( resolution > 0, "Timer resolution have to be positive!" );
+		GC_ASSERT( m_timerList.empty(), "Tried to change the timer resolution while timers exist!" );
+
+		m_timerResolution = resolution;
+	}
+
+	TimeValue TimerManager::clockElapsedTime( const ClockTimers& clockTimers )
+	{
+		return clockTimers.elapsedTime;
+	}
+
+	void TimerManager::scheduleTimer( Timer& timer )
+	{
+		GC_ASSERT( timer.m_isRunning && timer.m_clockTimers != nullptr, String( "Tried to schedule a timer that is not running! Timer name : " ) + timer.getName() );
+
+		// the bucket of the due time : once reached, the timer will be checked on each update until due
+		const TimeValue dueTime = timer.m_startTime + timer.m_waitTime;
+		const ClockTimers::TimerWheel::Tick tick = dueTime > 0 ? static_cast< ClockTimers::TimerWheel::Tick >( std::floor( dueTime / m_timerResolution ) ) : 0;
+
+		timer.m_wheelHandle = timer.m_clockTimers->wheel.schedule( tick, &timer );
+	}
+
+	void TimerManager::unscheduleTimer( Timer& timer )
+	{
+		if( timer.m_clockTimers == nullptr ) return;
+
+		timer.m_clockTimers->wheel.cancel( timer.m_wheelHandle );
+		timer.m_wheelHandle = ClockTimers::TimerWheel::Handle();
+
+		if( timer.m_dueIndex != INVALID_INDEX )
+		{
+			Timer* movedTimer = timer.m_clockTimers->removeDueTimer( timer.m_dueIndex );
+			if( movedTimer != nullptr ) movedTimer->m_dueIndex = timer.m_dueIndex;
+			timer.m_dueIndex = INVALID_INDEX;
+		}
+
+		if( timer.m_firedIndex != INVALID_INDEX )
+		{
+			// keep the fired order, the slot is skipped
+			m_firedTimers[ timer.m_firedIndex ] = nullptr;
+			timer.m_firedIndex = INVALID_INDEX;
+		}
+	}
+
+	void TimerManager::stopTimers( ClockTimers& clockTimers )
 	{
 		const std::size_t timerCount = m_timerList.size();
-		for( std::size_t i= 0; i < timerCount; ++i )
+		for( std::size_t i = 0; i < timerCount; ++i )
 		{
-			GC_ASSERT( m_timerList[i] != nullptr, "Found a null Timer in TimerManager!" );
-			m_timerList[i]->update();
+			Timer& timer = *m_timerList[i];
+			if( timer.m_clockTimers != &clockTimers ) continue;
+
+			const TimeValue timeSinceLastTrigger = timer.getTimeSinceLastTrigger();
+			unscheduleTimer( timer );
+			timer.m_clockTimers = nullptr;
+			timer.applyChanges( timeSinceLastTrigger );
 		}
+	}
+
+	TimerCallbackId TimerManager::scheduleCallback( const Clock& clock, TimeValue timeSpan, const TimerCallback& callback )
+	{
+		GC_ASSERT( callback, "Tried to schedule an empty timer callback!" );
+
+		CallbackCommand command;
+		command.callbackId = ++m_lastCallbackId;
+		command.clock = &clock;
+		command.timeSpan = timeSpan;
+		command.callback = callback;
+		m_callbackCommands.push( command );
+
+		return command.callbackId;
+	}
+
+	void TimerManager::cancelCallback( TimerCallbackId callbackId )
+	{
+		if( callbackId == 0 ) return;
 
+		// pushed after the schedule command because the id is known only once pushed
+		CallbackCommand command;
+		command.callbackId = callbackId;
+		m_callbackCommands.push( command );
+	}
+
+	std::size_t TimerManager::scheduledCallbackCount() const
+	{
+		return m_scheduledCallbacks->callbacks.size();
+	}
+
+	void TimerManager::applyCallbackCommands()
+	{
+		CallbackCommand command;
+		while( m_callbackCommands.tryPop( command ) )
+		{
+			if( command.clock != nullptr ) m_scheduledCallbacks->schedule( command );
+			else m_scheduledCallbacks->cancel( command.callbackId );
+		}
+	}
 
+	void TimerManager::updateTimers()
+	{
+		GC_ASSERT( m_firedTimers.empty(), "TimerManager::updateTimers() called while updating timers!" );
+
+		applyCallbackCommands();
+
+		// find the timers to trigger
+		for( Schedule::iterator it = m_schedule->begin(); it != m_schedule->end(); ++it )
+		{
+			ClockTimers& clockTimers = *it->second;
+			clockTimers.elapsedTime += clockTimers.clock.deltaTime();
+
+			// timers in the buckets reached are now checked on each update until due
+			if( clockTimers.elapsedTime > 0 )
+			{
+				const ClockTimers::TimerWheel::Tick tick = static_cast< ClockTimers::TimerWheel::Tick >( std::floor( clockTimers.elapsedTime / m_timerResolution ) );
+				clockTimers.wheel.advance( tick, clockTimers.expiredTimers );
+			}
+			else
+			{
+				clockTimers.wheel.advance( 0, clockTimers.expiredTimers );
+			}
+
+			const std::size_t expiredCount = clockTimers.expiredTimers.size();
+			for( std::size_t i = 0; i < expiredCount; ++i )
+			{
+				Timer* timer = clockTimers.expiredTimers[i];
+				timer->m_wheelHandle = ClockTimers::TimerWheel::Handle();
+				timer->m_dueIndex = clockTimers.dueTimers.size();
+				clockTimers.dueTimers.push_back( timer );
+				clockTimers.dueStartTimes.push_back( timer->m_startTime );
+				clockTimers.dueWaitTimes.push_back( timer->m_waitTime );
+			}
+			clockTimers.expiredTimers.clear();
+
+			clockTimers.findFiredTimers();
+
+			// remove the fired timers from the due ones, last first so the moved timers are not fired ones
+			const std::size_t firedCount = clockTimers.firedDueIndices.size();
+			const std::size_t firstFired = m_firedTimers.size();
+			m_firedTimers.resize( firstFired + firedCount );
+			for( std::size_t i = firedCount; i-- > 0; )
+			{
+				Timer* timer = clockTimers.dueTimers[ clockTimers.firedDueIndices[i] ];
+				unscheduleTimer( *timer );
+				timer->m_firedIndex = firstFired + i;
+				m_firedTimers[ firstFired + i ] = timer;
+			}
+		}
+
+		// trigger them
+		try
+		{
+			for( std::size_t i = 0; i < m_firedTimers.size(); ++i )
+			{
+				Timer* timer = m_firedTimers[i];
+				if( timer == nullptr ) continue; // unscheduled by a listener
+
+				timer->m_firedIndex = INVALID_INDEX;
+				try
+				{
+					timer->trigger();
+				}
+				catch( ... )
+				{
+					if( timer->m_isDestroyed ) deleteTimer( timer );
+					throw;
+				}
+
+				if( timer->m_isDestroyed ) deleteTimer( timer ); // destroyed by a listener
+			}
+		}
+		catch( ... )
+		{
+			// the timers not triggered yet will be checked again on the next update
+			for( std::size_t i = 0; i < m_firedTimers.size(); ++i )
+			{
+				Timer* timer = m_firedTimers[i];
+				if( timer == nullptr || timer->m_firedIndex == INVALID_INDEX ) continue;
+
+				timer->m_firedIndex = INVALID_INDEX;
+				scheduleTimer( *timer );
+			}
+			m_firedTimers.clear();
+			throw;
+		}
 
+		m_firedTimers.clear();
 	}
 }
\ No newline at end of file
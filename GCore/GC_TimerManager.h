@@ -4,16 +4,52 @@
 
 #include <vector>
 #include <unordered_map>
+#include <functional>
+#include <boost/cstdint.hpp>
+#include <boost/atomic.hpp>
 #include <boost/pool/poolfwd.hpp>
 
 #include "GC_Common.h"
+#include "GC_Time.h"
+#include "GC_ConcurrentQueue.h"
 
 namespace gcore
 {
 	class Timer;
 	class Clock;
 
+	/** Identify a Timer created by a TimerManager.
+		A handle becomes invalid when the timer is destroyed, even if it's memory is reused by a new timer,
+		so keeping a handle instead of a Timer pointer is safe.
+		@see TimerManager::getTimer( const TimerHandle& )
+	*/
+	struct TimerHandle
+	{
+		/// Constructor : invalid handle.
+		TimerHandle() : index( ~std::size_t( 0 ) ), generation( 0 ) {}
+
+		/// Slot of the timer in it's manager.
+		std::size_t index;
+
+		/// Generation of the slot when the timer was created.
+		unsigned int generation;
+
+		bool operator==( const TimerHandle& other ) const { return index == other.index && generation == other.generation; }
+		bool operator!=( const TimerHandle& other ) const { return !( *this == other ); }
+	};
+
+	/// Function called once by TimerManager::scheduleCallback().
+	typedef std::tr1::function< void () > TimerCallback;
+
+	/// Identify a callback scheduled by TimerManager::scheduleCallback(), 0 is invalid.
+	typedef boost::uint64_t TimerCallbackId;
+
 	/** Manage creation and destruction of Timers.
+		The running timers are scheduled in a timing wheel by clock, so an update only
+		look at the timers that have to trigger, not at all the created timers.
+		@par
+		TimerManager have to be used by one thread only, except scheduleCallback() and cancelCallback()
+		that can be called by any thread : they push commands in a lock-free queue applied by updateTimers().
 		@see Timer
 	*/
 	class GCORE_API TimerManager
@@ -22,7 +58,7 @@ namespace gcore
 
 		typedef std::vector<Timer*> TimerList;
 		typedef std::tr1::unordered_map< String , Timer* > TimerIndex;
-		typedef boost::object_pool< Timer > TimerPool;
+		typedef boost::pool<> TimerPool;
 
 		/** Constructor.
 			@param reserveTimerCount Timer memory reserved on this timer creation.
@@ -43,11 +79,19 @@ namespace gcore
 
 		/** Destroy a timer.
 			@remark The timer must have been created by this manager!
+			@remark Can be called by a listener of the timer being destroyed : 
+				it stops immediately but is destroyed once it's listeners are called.
 
 			@param timer Timer to destroy.
 		*/
 		void destroyTimer( Timer* timer );
 
+		/** Destroy a timer if the handle is still valid.
+			@param handle Handle of the timer to destroy.
+			@return false if the timer was already destroyed.
+		*/
+		bool destroyTimer( const TimerHandle& handle );
+
 		/** Destroy all timers created by this manager.
 		*/
 		void destroyAllTimers();
@@ -56,6 +100,14 @@ namespace gcore
 		*/
 		Timer* getTimer( const String& name );
 
+		/** Get a timer by it's handle.
+			@return The timer or null if it was destroyed.
+		*/
+		Timer* getTimer( const TimerHandle& handle ) const;
+
+		/// True if the timer of this handle is not destroyed.
+		bool isValid( const TimerHandle& handle ) const { return getTimer( handle ) != nullptr; }
+
 		/** Return the registered Timer list.
 		*/
 		const TimerList& getTimerList() const {return m_timerList;}
@@ -70,10 +122,117 @@ namespace gcore
 		*/
 		void updateTimers();
 
+		/** Call a function once a time span passed on a clock, using a trigger once timer.
+			@remark Can be called by any thread : the timer is created by the next updateTimers(),
+				the time span starts then and the function is called by the thread updating the timers.
+			@remark The clock must not be destroyed before the next updateTimers().
+			@remark A time span not positive make the function called by the next updateTimers().
+			@param clock Clock used as time reference provider for the timer.
+			@param timeSpan Time to wait before calling the function.
+			@param callback Function to call.
+			@return Id of the callback, to cancel it.
+		*/
+		TimerCallbackId scheduleCallback( const Clock& clock, TimeValue timeSpan, const TimerCallback& callback );
+
+		/** Cancel a callback if it was not called yet.
+			@remark Can be called by any thread : the callback is cancelled by the next updateTimers(),
+				so it can still be called by the current update.
+			@param callbackId Id returned by scheduleCallback(). Ignored if the callback was already called or cancelled.
+		*/
+		void cancelCallback( TimerCallbackId callbackId );
+
+		/// Number of callbacks waiting for their timer. Commands not applied yet are not counted.
+		std::size_t scheduledCallbackCount() const;
+
+		/** Set the size of the time buckets used to schedule the timers, in clock time.
+			Timers still trigger exactly when their wait time passed, this is only a performance setting :
+			timers due in the same bucket are checked together.
+			@remark Can't be changed while timers exist.
+		*/
+		void timerResolution( TimeValue resolution );
+
+		/// Size of the time buckets used to schedule the timers, in clock time. One millisecond by default.
+		TimeValue timerResolution() const { return m_timerResolution; }
+
 	protected:
 		
 	private:
 
+		friend class Timer;
+
+		/// Invalid index in the timer lists.
+		static const std::size_t INVALID_INDEX = ~std::size_t( 0 );
+
+		/// Scheduled timers of a clock.
+		struct ClockTimers;
+
+		/// Scheduled timers of all the clocks, watching for clocks destruction.
+		struct Schedule;
+		Schedule* m_schedule;
+
+		/// Size of the time buckets used to schedule the timers.
+		TimeValue m_timerResolution;
+
+		/// Timers to trigger in the current update.
+		TimerList m_firedTimers;
+
+		/// Command pushed by scheduleCallback() or cancelCallback() : cancel if the clock is null.
+		struct CallbackCommand
+		{
+			CallbackCommand() : callbackId( 0 ), clock( nullptr ), timeSpan( 0 ) {}
+
+			TimerCallbackId callbackId;
+			const Clock* clock;
+			TimeValue timeSpan;
+			TimerCallback callback;
+		};
+
+		/// Commands pushed by any thread, applied by updateTimers().
+		ConcurrentQueue< CallbackCommand > m_callbackCommands;
+
+		/// Last callback id provided.
+		boost::atomic< TimerCallbackId > m_lastCallbackId;
+
+		/// Callbacks waiting for their timer.
+		struct ScheduledCallbacks;
+		ScheduledCallbacks* m_scheduledCallbacks;
+
+		/// Apply the commands of scheduleCallback() and cancelCallback().
+		void applyCallbackCommands();
+
+		/// Slot of a timer handle.
+		struct TimerSlot
+		{
+			TimerSlot() : timer( nullptr ), generation( 0 ) {}
+
+			Timer* timer;
+			unsigned int generation;
+		};
+
+		/// Slots of the timer handles.
+		std::vector< TimerSlot > m_timerSlots;
+
+		/// Indices of the unused slots.
+		std::vector< std::size_t > m_freeTimerSlots;
+
+		/// Time elapsed for the timers of a clock.
+		static TimeValue clockElapsedTime( const ClockTimers& clockTimers );
+
+		/// Schedule a running timer to trigger once it's wait time passed.
+		void scheduleTimer( Timer& timer );
+
+		/// Remove the timer from the schedule.
+		void unscheduleTimer( Timer& timer );
+
+		/// Stop the timers of a clock being destroyed.
+		void stopTimers( ClockTimers& clockTimers );
+
+		/// Unregister the timer, making it's handle invalid, and stop it.
+		void releaseTimer( Timer& timer );
+
+		/// Call the destructor of the timer and free it's memory.
+		void deleteTimer( Timer* timer );
+
 		/// Pool of timer.
 		TimerPool* m_timerPool;
 
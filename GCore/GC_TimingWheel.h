@@ -0,0 +1,381 @@
+#ifndef GCORE_TIMINGWHEEL_H
+#define GCORE_TIMINGWHEEL_H
+#pragma once
+
+#include <vector>
+#include <boost/cstdint.hpp>
+
+#include "GC_Common.h"
+
+namespace gcore
+{
+	/** Hierarchical timing wheel : schedule values to expire at a tick.
+		
+		The values are stored in slots of wheels of growing granularity. Values of the lower wheel 
+		expire when the current tick reaches their slot, values of the upper wheels are cascaded
+		in the lower ones when the current tick reaches their slot.
+		Scheduling and cancelling are done in constant time, advancing costs the expired and cascaded 
+		values plus one step by lowest wheel turn (at most) : the empty slots are skipped.
+		@par
+		Values scheduled at a tick already reached expire on the next advance.
+		Values expiring in the same advance are provided in tick order, in scheduling order for the same tick 
+		(except if they were scheduled too far to be in the wheels).
+		@remark The ticks can't go backward.
+	*/
+	template< class T >
+	class TimingWheel
+	{
+	public:
+
+		typedef boost::uint64_t Tick;
+
+		/// Invalid node index.
+		static const std::size_t INVALID_INDEX = ~std::size_t( 0 );
+
+		/// Identify a scheduled value, to cancel it.
+		struct Handle
+		{
+			Handle() : index( INVALID_INDEX ), generation( 0 ) {}
+
+			std::size_t index;
+			unsigned int generation;
+		};
+
+		/** Constructor.
+			@param startTick Current tick of the wheel.
+		*/
+		explicit TimingWheel( Tick startTick = 0 )
+			: m_currentTick( startTick )
+			, m_count( 0 )
+			, m_firstFreeNode( INVALID_INDEX )
+		{
+			for( std::size_t i = 0; i < LIST_COUNT; ++i ) m_lists[i] = INVALID_INDEX;
+			for( std::size_t i = 0; i < LEVEL_COUNT; ++i ) m_occupiedSlots[i] = 0;
+		}
+
+		/// Last tick reached.
+		Tick currentTick() const { return m_currentTick; }
+
+		/// Number of values scheduled.
+		std::size_t size() const { return m_count; }
+
+		/// True if no value is scheduled.
+		bool empty() const { return m_count == 0; }
+
+		/** Schedule a value.
+			@param tick Tick to expire at.
+			@param value Value to provide when expired.
+			@return Handle of the scheduled value.
+		*/
+		Handle schedule( Tick tick, const T& value )
+		{
+			std::size_t index = m_firstFreeNode;
+			if( index != INVALID_INDEX )
+			{
+				m_firstFreeNode = m_nodes[ index ].next;
+			}
+			else
+			{
+				index = m_nodes.size();
+				m_nodes.push_back( Node() );
+			}
+
+			Node& node = m_nodes[ index ];
+			node.value = value;
+			node.tick = tick;
+			node.isScheduled = true;
+			insert( index );
+			++m_count;
+
+			Handle handle;
+			handle.index = index;
+			handle.generation = node.generation;
+			return handle;
+		}
+
+		/** Cancel a scheduled value.
+			@return false if the value already expired or was cancelled.
+		*/
+		bool cancel( const Handle& handle )
+		{
+			if( !isScheduled( handle ) ) return false;
+
+			unlink( handle.index );
+			release( handle.index );
+			return true;
+		}
+
+		/// True if the value is scheduled and not expired yet.
+		bool isScheduled( const Handle& handle ) const
+		{
+			return handle.index < m_nodes.size() 
+				&& m_nodes[ handle.index ].isScheduled 
+				&& m_nodes[ handle.index ].generation == handle.generation;
+		}
+
+		/** Advance the current tick, providing the values expired.
+			@param tick New current tick. Ignored if lower than the current tick.
+			@param expiredValues Receive the expired values, appended in tick order.
+		*/
+		void advance( Tick tick, std::vector< T >& expiredValues )
+		{
+			// values scheduled at a tick already reached
+			expireList( READY_LIST, expiredValues );
+
+			if( tick <= m_currentTick ) return;
+
+			while( m_currentTick < tick )
+			{
+				if( m_count == 0 )
+				{
+					m_currentTick = tick; // nothing to wait for
+					return;
+				}
+
+				// next tick to look at : next occupied slot of the lowest wheel or next turn of the lowest wheel
+				const std::size_t currentSlot = static_cast< std::size_t >( m_currentTick & SLOT_MASK );
+				const boost::uint64_t nextSlots = currentSlot == SLOT_MASK ? 0 : m_occupiedSlots[0] & ( ~boost::uint64_t( 0 ) << ( currentSlot + 1 ) );
+
+				Tick nextTick = ( m_currentTick | SLOT_MASK ) + 1;
+				if( nextSlots != 0 )
+				{
+					nextTick = ( m_currentTick & ~Tick( SLOT_MASK ) ) + lowestBit( nextSlots );
+				}
+
+				if( nextTick > tick )
+				{
+					m_currentTick = tick;
+					return;
+				}
+
+				m_currentTick = nextTick;
+
+				if( ( m_currentTick & SLOT_MASK ) == 0 )
+				{
+					cascade();
+				}
+
+				expireList( READY_LIST, expiredValues );
+				expireList( slotList( 0, static_cast< std::size_t >( m_currentTick & SLOT_MASK ) ), expiredValues );
+			}
+		}
+
+		/** Cancel all the scheduled values. */
+		void clear()
+		{
+			for( std::size_t i = 0; i < LIST_COUNT; ++i )
+			{
+				while( m_lists[i] != INVALID_INDEX )
+				{
+					const std::size_t index = m_lists[i];
+					unlink( index );
+					release( index );
+				}
+			}
+		}
+
+	private:
+
+		/// Each wheel have 64 slots, to use a 64bit mask of the occupied slots.
+		static const std::size_t SLOT_BITS = 6;
+		static const std::size_t SLOT_COUNT = 1 << SLOT_BITS;
+		static const std::size_t SLOT_MASK = SLOT_COUNT - 1;
+
+		/// Number of wheels : values beyond 2^36 ticks are in the overflow list.
+		static const std::size_t LEVEL_COUNT = 6;
+
+		/// Lists of values : one by slot, then the ready list and the overflow list.
+		static const std::size_t READY_LIST = LEVEL_COUNT * SLOT_COUNT;
+		static const std::size_t OVERFLOW_LIST = READY_LIST + 1;
+		static const std::size_t LIST_COUNT = OVERFLOW_LIST + 1;
+
+		struct Node
+		{
+			Node() : tick( 0 ), list( INVALID_INDEX ), previous( INVALID_INDEX ), next( INVALID_INDEX ), generation( 0 ), isScheduled( false ) {}
+
+			T value;
+			Tick tick;
+			std::size_t list;
+			std::size_t previous;
+			std::size_t next; // next free node when not scheduled
+			unsigned int generation;
+			bool isScheduled;
+		};
+
+		/// Last tick reached.
+		Tick m_currentTick;
+
+		/// Number of values scheduled.
+		std::size_t m_count;
+
+		/// Nodes storage, scheduled or free.
+		std::vector< Node > m_nodes;
+
+		/// First free node, or INVALID_INDEX.
+		std::size_t m_firstFreeNode;
+
+		/// First node of each list, or INVALID_INDEX.
+		std::size_t m_lists[ LIST_COUNT ];
+
+		/// Last node of each list, valid if the list is not empty.
+		std::size_t m_listTails[ LIST_COUNT ];
+
+		/// Occupied slots of each wheel.
+		boost::uint64_t m_occupiedSlots[ LEVEL_COUNT ];
+
+		static std::size_t slotList( std::size_t level, std::size_t slot ) { return level * SLOT_COUNT + slot; }
+
+		static std::size_t lowestBit( boost::uint64_t mask )
+		{
+			GC_ASSERT( mask != 0, "No bit set!" );
+			std::size_t bit = 0;
+			while( ( mask & 1 ) == 0 ) { mask >>= 1; ++bit; }
+			return bit;
+		}
+
+		/// Put a node in the list matching it's tick.
+		void insert( std::size_t index )
+		{
+			const Tick tick = m_nodes[ index ].tick;
+
+			if( tick <= m_currentTick )
+			{
+				append( READY_LIST, index );
+				return;
+			}
+
+			// the level is the highest group of bits that differs from the current tick
+			std::size_t level = 0;
+			Tick difference = ( tick ^ m_currentTick ) >> SLOT_BITS;
+			while( difference != 0 && level < LEVEL_COUNT )
+			{
+				difference >>= SLOT_BITS;
+				++level;
+			}
+
+			if( level == LEVEL_COUNT )
+			{
+				append( OVERFLOW_LIST, index );
+				return;
+			}
+
+			const std::size_t slot = static_cast< std::size_t >( ( tick >> ( level * SLOT_BITS ) ) & SLOT_MASK );
+			append( slotList( level, slot ), index );
+			m_occupiedSlots[ level ] |= boost::uint64_t( 1 ) << slot;
+		}
+
+		void append( std::size_t list, std::size_t index )
+		{
+			Node& node = m_nodes[ index ];
+			node.list = list;
+			node.next = INVALID_INDEX;
+
+			if( m_lists[ list ] == INVALID_INDEX )
+			{
+				node.previous = INVALID_INDEX;
+				m_lists[ list ] = index;
+			}
+			else
+			{
+				node.previous = m_listTails[ list ];
+				m_nodes[ node.previous ].next = index;
+			}
+			m_listTails[ list ] = index;
+		}
+
+		void unlink( std::size_t index )
+		{
+			Node& node = m_nodes[ index ];
+			const std::size_t list = node.list;
+
+			if( node.previous != INVALID_INDEX ) m_nodes[ node.previous ].next = node.next;
+			else m_lists[ list ] = node.next;
+
+			if( node.next != INVALID_INDEX ) m_nodes[ node.next ].previous = node.previous;
+			else m_listTails[ list ] = node.previous;
+
+			if( m_lists[ list ] == INVALID_INDEX && list < READY_LIST )
+			{
+				m_occupiedSlots[ list / SLOT_COUNT ] &= ~( boost::uint64_t( 1 ) << ( list % SLOT_COUNT ) );
+			}
+		}
+
+		/// Free a node, making it's handles invalid.
+		void release( std::size_t index )
+		{
+			Node& node = m_nodes[ index ];
+			node.value = T();
+			node.isScheduled = false;
+			++node.generation;
+			node.list = INVALID_INDEX;
+			node.next = m_firstFreeNode;
+			m_firstFreeNode = index;
+			--m_count;
+		}
+
+		/// Move the values of a list in the expired values.
+		void expireList( std::size_t list, std::vector< T >& expiredValues )
+		{
+			while( m_lists[ list ] != INVALID_INDEX )
+			{
+				const std::size_t index = m_lists[ list ];
+				unlink( index );
+				expiredValues.push_back( m_nodes[ index ].value );
+				release( index );
+			}
+		}
+
+		/// Move the values of a list in the lists matching their tick.
+		void redistributeList( std::size_t list )
+		{
+			std::size_t index = m_lists[ list ];
+			if( index == INVALID_INDEX ) return;
+
+			// detach the whole list first
+			m_lists[ list ] = INVALID_INDEX;
+			if( list < READY_LIST )
+			{
+				m_occupiedSlots[ list / SLOT_COUNT ] &= ~( boost::uint64_t( 1 ) << ( list % SLOT_COUNT ) );
+			}
+
+			while( index != INVALID_INDEX )
+			{
+				const std::size_t next = m_nodes[ index ].next;
+				insert( index );
+				index = next;
+			}
+		}
+
+		/// The lowest wheel did a turn : cascade the upper wheels slots reached.
+		void cascade()
+		{
+			// find the highest wheel that did a turn too
+			std::size_t level = 1;
+			while( level < LEVEL_COUNT && ( ( m_currentTick >> ( level * SLOT_BITS ) ) & SLOT_MASK ) == 0 )
+			{
+				++level;
+			}
+
+			if( level == LEVEL_COUNT )
+			{
+				redistributeList( OVERFLOW_LIST );
+				--level;
+			}
+
+			// from the highest to the lowest to have all the values in their final slot
+			for( ; level > 0; --level )
+			{
+				const std::size_t slot = static_cast< std::size_t >( ( m_currentTick >> ( level * SLOT_BITS ) ) & SLOT_MASK );
+				redistributeList( slotList( level, slot ) );
+			}
+		}
+
+		// non copyable
+		TimingWheel( const TimingWheel& );
+		void operator=( const TimingWheel& );
+
+	};
+
+}
+
+#endif
\ No newline at end of file
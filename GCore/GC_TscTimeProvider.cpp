@@ -0,0 +1,68 @@
+#include "GC_TscTimeProvider.h"
+#include "GC_MonotonicTimeProvider.h"
+
+#if defined( _M_IX86 ) || defined( _M_X64 ) || defined( __i386__ ) || defined( __x86_64__ )
+	#define GC_TSC_AVAILABLE
+	#if defined( _MSC_VER )
+		#include <intrin.h>
+	#else
+		#include <x86intrin.h>
+	#endif
+#endif
+
+namespace gcore
+{
+
+	TscTimeProvider::TscTimeProvider( TimeValue calibrationTime )
+		: TimeReferenceProvider()
+		, m_startTicks( 0 )
+		, m_ticksPerSecond( 0 )
+		, m_secondsPerTick( 0 )
+	{
+		GC_ASSERT( calibrationTime > 0, "TscTimeProvider calibration time have to be positive!" );
+
+		// count the ticks while the monotonic clock advance of the calibration time
+		MonotonicTimeProvider monotonicTime;
+		const TimeTicks monotonicStart = monotonicTime.getTicksSinceStart();
+		const TimeTicks counterStart = readCounter();
+
+		TimeTicks monotonicEnd = monotonicStart;
+		TimeTicks counterEnd = counterStart;
+		do
+		{
+			monotonicEnd = monotonicTime.getTicksSinceStart();
+			counterEnd = readCounter();
+		}
+		while( monotonicTime.ticksToTime( monotonicEnd - monotonicStart ) < calibrationTime );
+
+		const TimeValue measuredTime = monotonicTime.ticksToTime( monotonicEnd - monotonicStart );
+		m_ticksPerSecond = static_cast< TimeTicks >( static_cast< TimeValue >( counterEnd - counterStart ) / measuredTime + 0.5 );
+		m_secondsPerTick = 1.0 / static_cast< TimeValue >( m_ticksPerSecond );
+
+		m_startTicks = readCounter();
+	}
+
+	TimeValue TscTimeProvider::getTimeSinceStart() const
+	{
+		return static_cast< TimeValue >( getTicksSinceStart() ) * m_secondsPerTick;
+	}
+
+#ifdef GC_TSC_AVAILABLE
+
+	TimeTicks TscTimeProvider::readCounter()
+	{
+		return static_cast< TimeTicks >( __rdtsc() );
+	}
+
+#else
+
+	TimeTicks TscTimeProvider::readCounter()
+	{
+		// no time stamp counter : calibrated against itself
+		static const MonotonicTimeProvider monotonicTime;
+		return monotonicTime.getTicksSinceStart();
+	}
+
+#endif
+
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+#ifndef GCORE_TSCTIMEPROVIDER_H
+#define GCORE_TSCTIMEPROVIDER_H
+#pragma once
+
+#include "GC_Common.h"
+#include "GC_TimeReferenceProvider.h"
+
+namespace gcore
+{
+
+	/** Provide time from the time stamp counter of the processor, the cheapest time source to read.
+		The frequency of the counter is measured on creation against a MonotonicTimeProvider.
+		@remark The counter must be invariant (constant rate, synchronized between the cores), 
+			as on most x86 processors since 2008. Use MonotonicTimeProvider otherwise.
+		@remark On processors without time stamp counter, the system monotonic clock is used instead.
+		@remark The start time is the creation of the provider.
+	*/
+	class GCORE_API TscTimeProvider : public TimeReferenceProvider
+	{
+	public:
+
+		/** Constructor : measure the frequency of the counter.
+			@param calibrationTime Time spent measuring the frequency (in seconds) : longer is more precise.
+		*/
+		explicit TscTimeProvider( TimeValue calibrationTime = 0.02 );
+
+		/** Destructor.
+		*/
+		~TscTimeProvider(){}
+
+		/** Time passed since the creation of this provider.
+			@return Time value (in seconds).
+		*/
+		TimeValue getTimeSinceStart() const;
+
+		/** Counter ticks passed since the creation of this provider.
+			@return Time value (in ticks).
+		*/
+		TimeTicks getTicksSinceStart() const { return readCounter() - m_startTicks; }
+
+		/** Number of counter ticks in a second, as measured on creation.
+		*/
+		TimeTicks getTicksPerSecond() const { return m_ticksPerSecond; }
+
+	private:
+
+		/// Counter value on creation.
+		TimeTicks m_startTicks;
+
+		/// Measured number of ticks in a second.
+		TimeTicks m_ticksPerSecond;
+
+		/// Inverse of the number of ticks in a second.
+		TimeValue m_secondsPerTick;
+
+		/// Current value of the time stamp counter.
+		static TimeTicks readCounter();
+
+	};
+
+}
+
+#endif
\ No newline at end of file
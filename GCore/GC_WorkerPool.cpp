@@ -0,0 +1,229 @@
+#include <exception>
+#include <boost/bind.hpp>
+
+#include "GC_WorkerPool.h"
+
+namespace gcore
+{
+
+	WorkerPool::WorkerPool( unsigned int workerCount )
+		: m_nextQueue( 0 )
+		, m_pendingJobCount( 0 )
+		, m_queuedJobCount( 0 )
+		, m_stop( false )
+		, m_hasFailed( false )
+	{
+		// one queue by worker + the owner thread's one
+		m_queues.reserve( workerCount + 1 );
+		for( unsigned int i = 0; i < workerCount + 1; ++i )
+		{
+			m_queues.push_back( new JobQueue() );
+		}
+
+		m_threads.reserve( workerCount );
+		for( unsigned int i = 0; i < workerCount; ++i )
+		{
+			m_threads.push_back( new boost::thread( boost::bind( &WorkerPool::workerLoop, this, i ) ) );
+		}
+	}
+
+	WorkerPool::~WorkerPool()
+	{
+		// finish the current work first
+		if( m_pendingJobCount > 0 )
+		{
+			try { wait(); }
+			catch( ... ) { ; } // failures can't be reported while destroying the pool
+		}
+
+		{
+			boost::lock_guard< boost::mutex > lock( m_wakeMutex );
+			m_stop = true;
+		}
+		m_wakeCondition.notify_all();
+
+		for( std::size_t i = 0; i < m_threads.size(); ++i )
+		{
+			m_threads[i]->join();
+			delete m_threads[i];
+		}
+
+		for( std::size_t i = 0; i < m_queues.size(); ++i )
+		{
+			delete m_queues[i];
+		}
+	}
+
+	unsigned int WorkerPool::defaultWorkerCount()
+	{
+		const unsigned int hardwareThreads = boost::thread::hardware_concurrency();
+		return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+	}
+
+	unsigned int WorkerPool::currentQueueIndex() const
+	{
+		const boost::thread::id threadId = boost::this_thread::get_id();
+
+		const std::size_t threadCount = m_threads.size();
+		for( std::size_t i = 0; i < threadCount; ++i )
+		{
+			if( m_threads[i]->get_id() == threadId ) return static_cast< unsigned int >( i );
+		}
+
+		// not a worker : it's the owner thread
+		return static_cast< unsigned int >( threadCount );
+	}
+
+	void WorkerPool::push( const WorkerJob& job )
+	{
+		GC_ASSERT( job, "Tried to push an empty job in a WorkerPool!" );
+
+		unsigned int queueIndex = currentQueueIndex();
+		if( queueIndex == m_threads.size() && !m_threads.empty() )
+		{
+			// the owner thread push : distribute the jobs between the workers
+			queueIndex = m_nextQueue;
+			m_nextQueue = ( m_nextQueue + 1 ) % static_cast< unsigned int >( m_threads.size() );
+		}
+
+		++m_pendingJobCount;
+
+		{
+			JobQueue& queue = *m_queues[ queueIndex ];
+			boost::lock_guard< boost::mutex > lock( queue.mutex );
+			queue.jobs.push_back( job );
+		}
+
+		{
+			// lock to make sure a worker going to sleep will see this job
+			boost::lock_guard< boost::mutex > lock( m_wakeMutex );
+			++m_queuedJobCount;
+		}
+		m_wakeCondition.notify_one();
+	}
+
+	bool WorkerPool::takeJob( unsigned int queueIndex, WorkerJob& job )
+	{
+		if( m_queuedJobCount == 0 ) return false; // be lazy!
+
+		// first look in our own queue, last pushed first (better for cache)
+		{
+			JobQueue& queue = *m_queues[ queueIndex ];
+			boost::lock_guard< boost::mutex > lock( queue.mutex );
+			if( !queue.jobs.empty() )
+			{
+				job.swap( queue.jobs.back() );
+				queue.jobs.pop_back();
+				--m_queuedJobCount;
+				return true;
+			}
+		}
+
+		// then steal from the other queues, first pushed first
+		const std::size_t queueCount = m_queues.size();
+		for( std::size_t i = 1; i < queueCount; ++i )
+		{
+			JobQueue& queue = *m_queues[ ( queueIndex + i ) % queueCount ];
+			boost::lock_guard< boost::mutex > lock( queue.mutex );
+			if( !queue.jobs.empty() )
+			{
+				job.swap( queue.jobs.front() );
+				queue.jobs.pop_front();
+				--m_queuedJobCount;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void WorkerPool::runJob( WorkerJob& job )
+	{
+		try
+		{
+			job();
+		}
+		catch( const gcore::Exception& e )
+		{
+			boost::lock_guard< boost::mutex > lock( m_failureMutex );
+			if( !m_hasFailed ) { m_hasFailed = true; m_failureMessage = e.getMessage(); }
+		}
+		catch( const std::exception& e )
+		{
+			boost::lock_guard< boost::mutex > lock( m_failureMutex );
+			if( !m_hasFailed ) { m_hasFailed = true; m_failureMessage = e.what(); }
+		}
+		catch( ... )
+		{
+			boost::lock_guard< boost::mutex > lock( m_failureMutex );
+			if( !m_hasFailed ) { m_hasFailed = true; m_failureMessage = "Unknown exception."; }
+		}
+
+		job = WorkerJob(); // release the job data now
+
+		if( --m_pendingJobCount == 0 )
+		{
+			boost::lock_guard< boost::mutex > lock( m_wakeMutex );
+			m_doneCondition.notify_all();
+		}
+	}
+
+	void WorkerPool::workerLoop( unsigned int queueIndex )
+	{
+		WorkerJob job;
+
+		while( true )
+		{
+			if( takeJob( queueIndex, job ) )
+			{
+				runJob( job );
+				continue;
+			}
+
+			// nothing to do : sleep until a job is pushed
+			boost::unique_lock< boost::mutex > lock( m_wakeMutex );
+			while( !m_stop && m_queuedJobCount == 0 )
+			{
+				m_wakeCondition.wait( lock );
+			}
+
+			if( m_stop ) return;
+		}
+	}
+
+	void WorkerPool::wait()
+	{
+		GC_ASSERT( currentQueueIndex() == m_threads.size(), "WorkerPool::wait() called from a worker thread!" );
+
+		const unsigned int ownerQueue = static_cast< unsigned int >( m_threads.size() );
+		WorkerJob job;
+
+		while( m_pendingJobCount > 0 )
+		{
+			// help the workers
+			if( takeJob( ownerQueue, job ) )
+			{
+				runJob( job );
+				continue;
+			}
+
+			// nothing to steal : wait for the running jobs to finish
+			boost::unique_lock< boost::mutex > lock( m_wakeMutex );
+			while( m_pendingJobCount > 0 && m_queuedJobCount == 0 )
+			{
+				m_doneCondition.wait( lock );
+			}
+		}
+
+		// report failures
+		boost::lock_guard< boost::mutex > lock( m_failureMutex );
+		if( m_hasFailed )
+		{
+			const String message = m_failureMessage;
+			m_hasFailed = false;
+			m_failureMessage.clear();
+			GC_EXCEPTION << "A job failed in a WorkerPool : " << message;
+		}
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,130 @@
+#ifndef GCORE_WORKERPOOL_H
+#define GCORE_WORKERPOOL_H
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <functional>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/atomic.hpp>
+
+#include "GC_Common.h"
+#include "GC_String.h"
+
+namespace gcore
+{
+	/// Function-like object that can be executed by a WorkerPool.
+	typedef std::tr1::function< void () > WorkerJob;
+
+	/** Pool of worker threads executing jobs using work-stealing.
+		Each worker thread owns a job queue. Jobs pushed by the owner thread are
+		distributed between the queues, jobs pushed by a worker (from a job) go in
+		it's own queue. A worker with an empty queue steals jobs from the other queues.
+		@par
+		The owner thread helps executing the jobs while waiting in wait(), so
+		a WorkerPool without worker thread is valid : all the jobs will then be
+		executed by the owner thread in wait().
+		@remark wait() must be called only by the thread that created the pool, never from a job.
+		@remark If a job throws an exception, the other jobs are still executed and wait()
+		will throw an exception with the message of the first failure.
+	*/
+	class GCORE_API WorkerPool
+	{
+	public:
+
+		/** Constructor : start the worker threads.
+			@param workerCount Number of worker threads to create.
+		*/
+		explicit WorkerPool( unsigned int workerCount = defaultWorkerCount() );
+
+		/** Destructor : wait for the pushed jobs and stop the worker threads.
+		*/
+		~WorkerPool();
+
+		/** Number of worker threads to use by default : one less than the hardware threads,
+			as the owner thread participate in the jobs execution.
+		*/
+		static unsigned int defaultWorkerCount();
+
+		/// Number of worker threads of this pool (not counting the owner thread).
+		unsigned int workerCount() const { return static_cast< unsigned int >( m_threads.size() ); }
+
+		/** Push a job to execute as soon as possible.
+			@remark Can be called from the owner thread or from a job being executed by this pool.
+			@param job Job to execute.
+		*/
+		void push( const WorkerJob& job );
+
+		/** Execute jobs until all the pushed jobs (including the ones pushed by jobs) are done.
+			@remark Owner thread only.
+		*/
+		void wait();
+
+		/// Number of jobs pushed and not finished yet.
+		unsigned int pendingJobCount() const { return m_pendingJobCount.load(); }
+
+	private:
+
+		/// Job queue of a thread.
+		struct JobQueue
+		{
+			boost::mutex mutex;
+			std::deque< WorkerJob > jobs;
+		};
+
+		/// Job queues : one by worker thread, the last one is the owner thread's queue.
+		std::vector< JobQueue* > m_queues;
+
+		/// Worker threads.
+		std::vector< boost::thread* > m_threads;
+
+		/// Next queue to push a job in when pushing from the owner thread.
+		unsigned int m_nextQueue;
+
+		/// Jobs pushed and not finished yet.
+		boost::atomic< unsigned int > m_pendingJobCount;
+
+		/// Jobs pushed and not taken by a thread yet.
+		boost::atomic< unsigned int > m_queuedJobCount;
+
+		/// True when worker threads have to stop.
+		bool m_stop;
+
+		/// Mutex used with the conditions to sleep while there is nothing to do.
+		boost::mutex m_wakeMutex;
+
+		/// Notified when a job is pushed or the pool is stopping.
+		boost::condition_variable m_wakeCondition;
+
+		/// Notified when all pending jobs are done.
+		boost::condition_variable m_doneCondition;
+
+		/// Message of the first job failure since the last wait() or empty if none.
+		String m_failureMessage;
+		bool m_hasFailed;
+		boost::mutex m_failureMutex;
+
+		/// Main loop of a worker thread.
+		void workerLoop( unsigned int queueIndex );
+
+		/// Take a job from the given queue or steal one from another queue.
+		bool takeJob( unsigned int queueIndex, WorkerJob& job );
+
+		/// Execute a job, manage failures and job count.
+		void runJob( WorkerJob& job );
+
+		/// Index of the queue of the calling thread.
+		unsigned int currentQueueIndex() const;
+
+		// non copyable
+		WorkerPool( const WorkerPool& );
+		void operator=( const WorkerPool& );
+
+	};
+
+
+}
+
+#endif
\ No newline at end of file